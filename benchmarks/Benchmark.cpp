@@ -0,0 +1,203 @@
+#include "Benchmark.hpp"
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <streambuf>
+#include <thread>
+
+namespace {
+
+// Swallows std::cout chatter from the code under test so it neither skews
+// timings with terminal I/O nor corrupts machine-readable output on stdout
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+const size_t maxIterations = 1000000000;
+
+void printUsage() {
+    std::cerr << "Usage: solarscope_bench [--filter <substring>] [--format json|csv|console]\n"
+                 "                        [--out <file>] [--min-time <seconds>] [--repetitions <n>]\n"
+                 "Run from the repository root so textures and models can be found."
+              << std::endl;
+}
+
+std::string currentDate() {
+    std::time_t now = std::time(nullptr);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+    return buffer;
+}
+
+void writeJson(std::ostream& out, const std::vector<BenchmarkResult>& results, const BenchmarkOptions& options) {
+    out << std::setprecision(6);
+    out << "{\n  \"context\": {\n";
+    out << "    \"date\": \"" << currentDate() << "\",\n";
+    out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#if defined(__VERSION__)
+    out << "    \"compiler\": \"" << __VERSION__ << "\",\n";
+#endif
+#if defined(NDEBUG)
+    out << "    \"build_type\": \"release\",\n";
+#else
+    out << "    \"build_type\": \"debug\",\n";
+#endif
+    out << "    \"repetitions\": " << options.repetitions << ",\n";
+    out << "    \"min_time_s\": " << options.minTimeSeconds << "\n";
+    out << "  },\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& result = results[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\"name\": \"" << result.name << "\", \"iterations\": " << result.iterations
+            << ", \"mean_ns\": " << result.meanNs << ", \"median_ns\": " << result.medianNs
+            << ", \"min_ns\": " << result.minNs << ", \"stddev_ns\": " << result.stddevNs
+            << ", \"items_per_second\": " << result.itemsPerSecond << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void writeCsv(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+    out << std::setprecision(6);
+    out << "name,iterations,mean_ns,median_ns,min_ns,stddev_ns,items_per_second\n";
+    for (const BenchmarkResult& result : results) {
+        out << result.name << ',' << result.iterations << ',' << result.meanNs << ',' << result.medianNs << ','
+            << result.minNs << ',' << result.stddevNs << ',' << result.itemsPerSecond << '\n';
+    }
+}
+
+void writeConsole(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+    out << std::left << std::setw(44) << "Benchmark" << std::right << std::setw(14) << "median ns" << std::setw(12)
+        << "stddev %" << std::setw(14) << "iterations" << std::setw(16) << "items/s" << '\n';
+    out << std::string(100, '-') << '\n';
+    out << std::fixed;
+    for (const BenchmarkResult& result : results) {
+        double stddevPercent = result.meanNs > 0.0 ? 100.0 * result.stddevNs / result.meanNs : 0.0;
+        out << std::left << std::setw(44) << result.name << std::right << std::setprecision(1) << std::setw(14)
+            << result.medianNs << std::setw(12) << stddevPercent << std::setw(14) << result.iterations
+            << std::setprecision(0) << std::setw(16) << result.itemsPerSecond << '\n';
+    }
+    out << std::defaultfloat;
+}
+
+}
+
+bool BenchmarkOptions::parse(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--filter" && hasValue) {
+            filter = argv[++i];
+        } else if (arg == "--format" && hasValue) {
+            format = argv[++i];
+        } else if (arg == "--out" && hasValue) {
+            outputPath = argv[++i];
+        } else if (arg == "--min-time" && hasValue) {
+            minTimeSeconds = std::atof(argv[++i]);
+        } else if (arg == "--repetitions" && hasValue) {
+            repetitions = std::max(1, std::atoi(argv[++i]));
+        } else {
+            printUsage();
+            return false;
+        }
+    }
+    if (format != "json" && format != "csv" && format != "console") {
+        printUsage();
+        return false;
+    }
+    return true;
+}
+
+void BenchmarkRunner::add(const std::string& name, std::function<void(BenchmarkState&)> body) {
+    entries.push_back(Entry{name, std::move(body)});
+}
+
+BenchmarkResult BenchmarkRunner::measure(const Entry& entry, const BenchmarkOptions& options) const {
+    double minTimeNs = options.minTimeSeconds * 1.0e9;
+
+    // Grow the iteration count until one run takes at least the minimum time
+    size_t iterations = 1;
+    while (iterations < maxIterations) {
+        BenchmarkState state(iterations);
+        entry.body(state);
+        double elapsed = state.elapsedNs();
+        if (elapsed >= minTimeNs) {
+            break;
+        }
+        double growth = elapsed > 0.0 ? minTimeNs * 1.2 / elapsed : 10.0;
+        growth = std::min(std::max(growth, 1.5), 10.0);
+        iterations = std::min(maxIterations, static_cast<size_t>(std::ceil(iterations * growth)));
+    }
+
+    std::vector<double> samples;
+    double items = 0.0;
+    for (int i = 0; i < options.repetitions; ++i) {
+        BenchmarkState state(iterations);
+        entry.body(state);
+        samples.push_back(state.elapsedNs() / iterations);
+        items = state.items();
+    }
+
+    std::sort(samples.begin(), samples.end());
+    double mean = 0.0;
+    for (double sample : samples) {
+        mean += sample;
+    }
+    mean /= samples.size();
+    double variance = 0.0;
+    for (double sample : samples) {
+        variance += (sample - mean) * (sample - mean);
+    }
+    variance /= samples.size();
+
+    size_t middle = samples.size() / 2;
+    double median = samples.size() % 2 ? samples[middle] : 0.5 * (samples[middle - 1] + samples[middle]);
+
+    BenchmarkResult result;
+    result.name = entry.name;
+    result.iterations = iterations;
+    result.meanNs = mean;
+    result.medianNs = median;
+    result.minNs = samples.front();
+    result.stddevNs = std::sqrt(variance);
+    result.itemsPerSecond = (items > 0.0 && median > 0.0) ? items * 1.0e9 / median : 0.0;
+    return result;
+}
+
+int BenchmarkRunner::run(const BenchmarkOptions& options) {
+    NullBuffer nullBuffer;
+    std::streambuf* stdoutBuffer = std::cout.rdbuf();
+
+    std::vector<BenchmarkResult> results;
+    for (const Entry& entry : entries) {
+        if (!options.filter.empty() && entry.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        std::cerr << "Running " << entry.name << "..." << std::endl;
+        std::cout.rdbuf(&nullBuffer);
+        results.push_back(measure(entry, options));
+        std::cout.rdbuf(stdoutBuffer);
+    }
+
+    std::ofstream file;
+    if (!options.outputPath.empty()) {
+        file.open(options.outputPath);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open output file: " << options.outputPath << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = options.outputPath.empty() ? std::cout : file;
+
+    if (options.format == "csv") {
+        writeCsv(out, results);
+    } else if (options.format == "console") {
+        writeConsole(out, results);
+    } else {
+        writeJson(out, results, options);
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Minimal self-contained microbenchmark harness.
+// A benchmark body receives a BenchmarkState and loops on keepRunning();
+// anything before the loop is setup and is not timed:
+//
+//     runner.add("sphere/indices/40", [](BenchmarkState& state) {
+//         std::vector<unsigned int> indices;
+//         while (state.keepRunning()) { ... }
+//         state.setItemsPerIteration(indices.size());
+//     });
+class BenchmarkState {
+public:
+    explicit BenchmarkState(size_t iterations)
+        : iterations(iterations), remaining(iterations), itemsPerIteration(0.0) {}
+
+    bool keepRunning() {
+        if (remaining == iterations) {
+            startTime = std::chrono::steady_clock::now();
+        }
+        if (remaining == 0) {
+            endTime = std::chrono::steady_clock::now();
+            return false;
+        }
+        --remaining;
+        return true;
+    }
+
+    // Work items handled per iteration (vertices, bodies, bytes...), reported as items_per_second
+    void setItemsPerIteration(double items) { itemsPerIteration = items; }
+
+    size_t iterationCount() const { return iterations; }
+    double elapsedNs() const { return std::chrono::duration<double, std::nano>(endTime - startTime).count(); }
+    double items() const { return itemsPerIteration; }
+
+private:
+    size_t iterations;
+    size_t remaining;
+    double itemsPerIteration;
+    std::chrono::steady_clock::time_point startTime;
+    std::chrono::steady_clock::time_point endTime;
+};
+
+// Keeps the compiler from optimizing away a computed value
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+struct BenchmarkOptions {
+    std::string filter;       // Only run benchmarks whose name contains this
+    std::string format;       // "json" (default), "csv" or "console"
+    std::string outputPath;   // Empty = stdout
+    double minTimeSeconds;    // Target run time per repetition
+    int repetitions;          // Timed runs per benchmark
+
+    BenchmarkOptions() : format("json"), minTimeSeconds(0.2), repetitions(5) {}
+
+    // Returns false (after printing usage) on invalid arguments
+    bool parse(int argc, char* argv[]);
+};
+
+struct BenchmarkResult {
+    std::string name;
+    size_t iterations;        // Per repetition
+    double meanNs;            // Per iteration
+    double medianNs;
+    double minNs;
+    double stddevNs;
+    double itemsPerSecond;    // From the median, 0 if not reported
+};
+
+class BenchmarkRunner {
+public:
+    void add(const std::string& name, std::function<void(BenchmarkState&)> body);
+
+    // Runs all matching benchmarks and writes the report; returns the process exit code
+    int run(const BenchmarkOptions& options);
+
+private:
+    struct Entry {
+        std::string name;
+        std::function<void(BenchmarkState&)> body;
+    };
+
+    std::vector<Entry> entries;
+
+    BenchmarkResult measure(const Entry& entry, const BenchmarkOptions& options) const;
+};
@@ -0,0 +1,421 @@
+// CPU microbenchmarks for the code that runs every frame or at startup.
+// None of the benchmarks create a window or GL context, so the suite runs on
+// machines without a GPU. Run from the repository root:
+//
+//     ./solarscope_bench --format json --out bench.json
+//
+// Built with SOLARSCOPE_HEADLESS (no GL/Assimp libraries) only the simulation
+// benchmarks are compiled in.
+#include <glm/glm.hpp>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef SOLARSCOPE_HEADLESS
+#include <GL/glew.h>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include "include/stb_image.h"
+#include "include/models/Model.hpp"
+#endif
+
+#include "include/simulation/Ephemeris.hpp"
+#include "include/simulation/SceneGenerator.hpp"
+#include "include/simulation/SolarSystem.hpp"
+#include "include/space_objects/CelestialBody.hpp"
+#include "include/space_objects/Comet.hpp"
+#include "include/utils/SphereUtils.hpp"
+#include "include/world/Camera.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace glm;
+
+namespace {
+
+CelestialBody makeBody(int index) {
+    return CelestialBody::create(0.1f + 0.01f * (index % 30),
+                                 8.0f + 0.5f * (index % 100),
+                                 0.2f + 0.02f * (index % 90),
+                                 10.0f + (index % 25));
+}
+
+Comet makeComet(int maxTrailPoints) {
+    Comet comet = Comet::create(vec3(0.0f, 0.0f, -20.0f), 45.0f, 0.85f);
+    comet.maxTrailPoints = maxTrailPoints;
+    return comet;
+}
+
+void addSphereBenchmarks(BenchmarkRunner& runner) {
+    for (unsigned int resolution : {10u, 40u, 80u, 160u, 320u}) {
+        std::string suffix = "/" + std::to_string(resolution);
+
+        runner.add("sphere/vertices_uvs" + suffix, [resolution](BenchmarkState& state) {
+            while (state.keepRunning()) {
+                std::vector<vec3> vertices;
+                std::vector<vec2> uvs;
+                SphereUtils::generateSphereVerticesAndUVs(resolution, resolution, vertices, uvs);
+                doNotOptimize(vertices.data());
+                doNotOptimize(uvs.data());
+            }
+            state.setItemsPerIteration(resolution * resolution);
+        });
+
+        runner.add("sphere/indices" + suffix, [resolution](BenchmarkState& state) {
+            size_t count = 0;
+            while (state.keepRunning()) {
+                std::vector<unsigned int> indices;
+                SphereUtils::generateSphereIndices(resolution, resolution, indices);
+                count = indices.size();
+                doNotOptimize(indices.data());
+            }
+            state.setItemsPerIteration(count);
+        });
+    }
+}
+
+void addCelestialBodyBenchmarks(BenchmarkRunner& runner) {
+    for (int bodyCount : {10, 1000, 100000}) {
+        std::string suffix = "/" + std::to_string(bodyCount);
+
+        runner.add("celestial_body/update" + suffix, [bodyCount](BenchmarkState& state) {
+            std::vector<CelestialBody> bodies;
+            for (int i = 0; i < bodyCount; ++i) {
+                bodies.push_back(makeBody(i));
+            }
+            vec3 sunPosition(0.0f, 0.0f, -20.0f);
+            double orbAngle = 0.0;
+
+            while (state.keepRunning()) {
+                orbAngle += 20.0 / 60.0;
+                for (CelestialBody& body : bodies) {
+                    body.update(sunPosition, orbAngle, 1.0f / 60.0f);
+                }
+                doNotOptimize(bodies.data());
+            }
+            state.setItemsPerIteration(bodyCount);
+        });
+
+        runner.add("celestial_body/world_matrix" + suffix, [bodyCount](BenchmarkState& state) {
+            std::vector<CelestialBody> bodies;
+            for (int i = 0; i < bodyCount; ++i) {
+                bodies.push_back(makeBody(i));
+                bodies.back().update(vec3(0.0f), 30.0f * i, 0.5f);
+            }
+
+            while (state.keepRunning()) {
+                for (const CelestialBody& body : bodies) {
+                    mat4 worldMatrix = body.getWorldMatrix();
+                    doNotOptimize(worldMatrix);
+                }
+            }
+            state.setItemsPerIteration(bodyCount);
+        });
+    }
+}
+
+void addCometBenchmarks(BenchmarkRunner& runner) {
+    for (int trailLength : {150, 1000, 10000}) {
+        std::string suffix = "/" + std::to_string(trailLength);
+
+        // Realistic 60 fps stepping: a new trail point every 0.1 s, aging every frame
+        runner.add("comet/update" + suffix, [trailLength](BenchmarkState& state) {
+            Comet comet = makeComet(trailLength);
+            vec3 sunPosition(0.0f, 0.0f, -20.0f);
+            double time = 0.0;
+            for (int i = 0; i < trailLength; ++i) {
+                time += 0.25;
+                comet.updateTrail(static_cast<float>(time), 0.25f, sunPosition);
+            }
+
+            while (state.keepRunning()) {
+                time += 1.0 / 60.0;
+                comet.update(time, sunPosition, static_cast<float>(time), 1.0f / 60.0f);
+                doNotOptimize(comet.trail.data());
+            }
+            state.setItemsPerIteration(trailLength);
+        });
+
+        // Worst case: every update inserts a trail point into a full trail
+        runner.add("comet/update_trail_insert" + suffix, [trailLength](BenchmarkState& state) {
+            Comet comet = makeComet(trailLength);
+            vec3 sunPosition(0.0f, 0.0f, -20.0f);
+            double time = 0.0;
+            for (int i = 0; i < trailLength; ++i) {
+                time += 0.25;
+                comet.updateTrail(static_cast<float>(time), 0.25f, sunPosition);
+            }
+
+            while (state.keepRunning()) {
+                time += 0.25;
+                comet.updateTrail(static_cast<float>(time), 0.25f, sunPosition);
+                doNotOptimize(comet.trail.data());
+            }
+            state.setItemsPerIteration(trailLength);
+        });
+    }
+}
+
+void addSolarSystemBenchmarks(BenchmarkRunner& runner) {
+    // One frame of the default scene: all bodies plus both comets
+    runner.add("solar_system/update", [](BenchmarkState& state) {
+        SolarSystem solarSystem = SolarSystem::createDefault();
+        double time = 0.0;
+        while (state.keepRunning()) {
+            time += 1.0 / 60.0;
+            solarSystem.update(1.0f / 60.0f, static_cast<float>(time), 1.0f / 60.0f);
+            doNotOptimize(solarSystem.bodies.data());
+        }
+        state.setItemsPerIteration(solarSystem.bodies.size() + solarSystem.comets.size());
+    });
+
+    // Deep moon systems: planets with three moons, each with three moons, three levels down
+    for (int planetCount : {25, 2500}) {
+        SceneGenerator::Options options;
+        options.planets = planetCount;
+        options.moonsPerBody = 3;
+        options.moonDepth = 3;
+        options.comets = 0;
+        std::string suffix = "/" + std::to_string(planetCount * 40);
+
+        runner.add("solar_system/update_bodies" + suffix, [options](BenchmarkState& state) {
+            SolarSystem solarSystem = SceneGenerator::generate(options);
+            double time = 0.0;
+            while (state.keepRunning()) {
+                time += 1.0 / 60.0;
+                solarSystem.updateBodies(1.0f / 60.0f, static_cast<float>(time));
+                doNotOptimize(solarSystem.transforms.worldMatrices.data());
+            }
+            state.setItemsPerIteration(solarSystem.bodies.size());
+        });
+
+        // Jump far ahead: costs the same as a normal frame however far the jump
+        runner.add("solar_system/seek" + suffix, [options](BenchmarkState& state) {
+            SolarSystem solarSystem = SceneGenerator::generate(options);
+            double time = 0.0;
+            while (state.keepRunning()) {
+                time += 86400.0 * 365.0;
+                solarSystem.seek(time, 0.0f);
+                doNotOptimize(solarSystem.transforms.worldMatrices.data());
+            }
+            state.setItemsPerIteration(solarSystem.bodies.size());
+        });
+
+        // Paused: nothing moves, so the hierarchy only checks its dirty flags
+        runner.add("solar_system/update_bodies_paused" + suffix, [options](BenchmarkState& state) {
+            SolarSystem solarSystem = SceneGenerator::generate(options);
+            while (state.keepRunning()) {
+                solarSystem.updateBodies(0.0f, 0.0f);
+                doNotOptimize(solarSystem.transforms.worldMatrices.data());
+            }
+            state.setItemsPerIteration(solarSystem.bodies.size());
+        });
+    }
+
+    // Simulation LOD: a belt-heavy scene seen from the default camera. Small and off-screen
+    // bodies update every few frames or in round-robin buckets; the time budget is off so
+    // every run evaluates the same bodies.
+    for (int bodyCount : {10000, 100000}) {
+        SceneGenerator::Options options;
+        options.planets = bodyCount / 10;
+        options.moonsPerBody = 1;
+        options.asteroids = bodyCount - 2 * options.planets;
+        options.comets = 0;
+
+        runner.add("solar_system/update_bodies_lod/" + std::to_string(bodyCount), [options](BenchmarkState& state) {
+            SolarSystem solarSystem = SceneGenerator::generate(options);
+            Camera camera;
+            solarSystem.scheduler.budgetMicroseconds = 0.0;
+            solarSystem.scheduler.setView(camera.updateViewMatrix(),
+                                          glm::perspective(70.0f, 800.0f / 600.0f, 0.01f, 100.0f),
+                                          600.0f);
+            double time = 0.0;
+            while (state.keepRunning()) {
+                time += 1.0 / 60.0;
+                solarSystem.updateBodies(1.0f / 60.0f, static_cast<float>(time));
+                doNotOptimize(solarSystem.transforms.worldMatrices.data());
+            }
+            state.setItemsPerIteration(solarSystem.bodies.size());
+        });
+    }
+}
+
+// Circular orbits fitted like tools/ephemeris_gen.cpp, with the default scene's planet names
+bool writeBenchmarkEphemeris(const std::string& path) {
+    const char* names[] = {"mercury", "venus", "earth", "mars", "jupiter", "saturn", "uranus", "neptune"};
+    const double startJd = Ephemeris::julianDate(2000, 1, 1);
+    const double endJd = Ephemeris::julianDate(2100, 1, 1);
+    const unsigned int count = 12;
+    const double pi = 3.14159265358979323846;
+
+    std::vector<Ephemeris::BodyTable> tables;
+    for (int planet = 0; planet < 8; ++planet) {
+        Ephemeris::BodyTable table;
+        table.body = Ephemeris::Body{names[planet], -1, count, 32.0, 0, 0};
+        table.body.granuleCount = static_cast<uint32_t>((endJd - startJd) / table.body.granuleDays) + 1;
+        double radius = 0.4 + planet * 4.0;
+        double period = 88.0 * std::pow(radius / 0.4, 1.5);
+        for (uint32_t granule = 0; granule < table.body.granuleCount; ++granule) {
+            for (int axis = 0; axis < 3; ++axis) {
+                for (unsigned int j = 0; j < count; ++j) {
+                    double sum = 0.0;
+                    for (unsigned int k = 0; k < count; ++k) {
+                        double node = std::cos(pi * (k + 0.5) / count);
+                        double angle = 2.0 * pi * (granule + (node + 1.0) * 0.5) * table.body.granuleDays / period;
+                        double value = axis == 0 ? std::cos(angle) : axis == 1 ? std::sin(angle) : 0.0;
+                        sum += radius * value * std::cos(pi * j * (k + 0.5) / count);
+                    }
+                    table.coefficients.push_back(sum * (j == 0 ? 1.0 : 2.0) / count);
+                }
+            }
+        }
+        tables.push_back(table);
+    }
+    return Ephemeris::write(path, startJd, endJd, tables);
+}
+
+void addEphemerisBenchmarks(BenchmarkRunner& runner) {
+    std::string path = (std::filesystem::temp_directory_path() / "solarscope_bench.ephem").string();
+    if (!writeBenchmarkEphemeris(path)) {
+        std::cerr << "Skipping ephemeris benchmarks, failed to write: " << path << std::endl;
+        return;
+    }
+    auto ephemeris = std::make_shared<Ephemeris>();
+    if (!ephemeris->open(path)) {
+        return;
+    }
+
+    // One position per planet per frame, a day apart, walking through the table
+    runner.add("ephemeris/position", [ephemeris](BenchmarkState& state) {
+        double jd = ephemeris->startJd();
+        int bodyCount = static_cast<int>(ephemeris->bodyList().size());
+        while (state.keepRunning()) {
+            jd = jd + 1.0 < ephemeris->endJd() ? jd + 1.0 : ephemeris->startJd();
+            for (int body = 0; body < bodyCount; ++body) {
+                dvec3 position = ephemeris->position(body, jd);
+                doNotOptimize(position);
+            }
+        }
+        state.setItemsPerIteration(bodyCount);
+    });
+
+    // A frame of the default scene with the planets driven by the table
+    runner.add("solar_system/update_ephemeris", [ephemeris](BenchmarkState& state) {
+        SolarSystem solarSystem = SolarSystem::createDefault();
+        solarSystem.attachEphemeris(ephemeris, ephemeris->startJd());
+        double time = 0.0;
+        while (state.keepRunning()) {
+            time += 1.0 / 60.0;
+            solarSystem.update(1.0f / 60.0f, static_cast<float>(time), 1.0f / 60.0f);
+            doNotOptimize(solarSystem.bodies.data());
+        }
+        state.setItemsPerIteration(solarSystem.bodies.size() + solarSystem.comets.size());
+    });
+}
+
+#ifndef SOLARSCOPE_HEADLESS
+std::vector<unsigned char> readBinaryFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return {};
+    }
+    return std::vector<unsigned char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+std::string fileName(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+void addImageDecodeBenchmarks(BenchmarkRunner& runner) {
+    const char* images[] = {
+        "textures/planet/sun.jpg",
+        "textures/comet/comet.jpg",
+        "textures/planet/saturn_rings.png",
+        "textures/skybox/1.png",
+    };
+
+    for (const char* path : images) {
+        std::vector<unsigned char> bytes = readBinaryFile(path);
+        if (bytes.empty()) {
+            std::cerr << "Skipping image decode benchmark, file not found: " << path << std::endl;
+            continue;
+        }
+
+        // Decode from memory, as TextureUtils::loadTexture does via stbi_load, without the file I/O
+        runner.add("image/decode/" + fileName(path), [bytes](BenchmarkState& state) {
+            int width = 0, height = 0, channels = 0;
+            while (state.keepRunning()) {
+                unsigned char* data =
+                    stbi_load_from_memory(bytes.data(), static_cast<int>(bytes.size()), &width, &height, &channels, 0);
+                doNotOptimize(data);
+                stbi_image_free(data);
+            }
+            state.setItemsPerIteration(static_cast<double>(width) * height);
+        });
+    }
+}
+
+void addModelBenchmarks(BenchmarkRunner& runner, Assimp::Importer& importer) {
+    const char* path = "models/rubber_duck/scene.gltf";
+
+    runner.add("model/import/rubber_duck", [path](BenchmarkState& state) {
+        Assimp::Importer localImporter;
+        while (state.keepRunning()) {
+            const aiScene* scene = localImporter.ReadFile(path, Model::importFlags);
+            doNotOptimize(scene);
+            localImporter.FreeScene();
+        }
+    });
+
+    const aiScene* scene = importer.ReadFile(path, Model::importFlags);
+    if (!scene || !scene->mRootNode) {
+        std::cerr << "Skipping model conversion benchmark, failed to import: " << path << std::endl;
+        return;
+    }
+
+    runner.add("model/process_node/rubber_duck", [scene](BenchmarkState& state) {
+        size_t vertexCount = 0;
+        while (state.keepRunning()) {
+            Model model;
+            Model::processNode(model, scene->mRootNode, scene, false);
+            vertexCount = 0;
+            for (const Mesh& mesh : model.meshes) {
+                vertexCount += mesh.vertices.size();
+            }
+            doNotOptimize(model.meshes.data());
+        }
+        state.setItemsPerIteration(vertexCount);
+    });
+}
+#endif
+
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    if (!options.parse(argc, argv)) {
+        return 1;
+    }
+
+    BenchmarkRunner runner;
+    addSphereBenchmarks(runner);
+    addCelestialBodyBenchmarks(runner);
+    addCometBenchmarks(runner);
+    addSolarSystemBenchmarks(runner);
+    addEphemerisBenchmarks(runner);
+
+#ifndef SOLARSCOPE_HEADLESS
+    // Keeps the imported scene alive for the model conversion benchmark
+    Assimp::Importer importer;
+    addImageDecodeBenchmarks(runner);
+    addModelBenchmarks(runner, importer);
+#endif
+
+    return runner.run(options);
+}
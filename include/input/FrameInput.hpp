@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+
+// Keys the app reacts to. FrameInput stores them as bit indices so recordings
+// don't depend on GLFW key codes; GlfwInput maps them to GLFW keys.
+// Append new keys at the end: the index is part of the recording format.
+enum class Key : uint8_t {
+    W, A, S, D, Q, E, LeftShift, RightShift,
+    Left, Right, Up, Down,
+    Space, Equal, KeypadAdd, Minus, KeypadSubtract,
+    Num0, Num1, Num2, Num3, Num4, Num9,
+    C, I, R, X, Escape, F1, F2,
+    LeftBracket, RightBracket,
+    Count
+};
+
+// Input for one frame, either polled from the window or read from a recording
+struct FrameInput {
+    float time;             // Seconds since startup at the start of the frame
+    float dt;               // Time since the previous frame
+    double cursorX;         // Cursor position in screen coordinates
+    double cursorY;
+    uint64_t keys;          // One bit per Key held this frame
+    uint64_t previousKeys;  // Keys held in the previous frame
+
+    bool isDown(Key key) const { return (keys >> static_cast<int>(key)) & 1; }
+
+    // True only on the frame the key goes down
+    bool pressed(Key key) const { return isDown(key) && !((previousKeys >> static_cast<int>(key)) & 1); }
+};
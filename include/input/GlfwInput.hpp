@@ -0,0 +1,14 @@
+#pragma once
+#include <GLFW/glfw3.h>
+#include "include/input/FrameInput.hpp"
+
+// Polls the window's keyboard and cursor state into a FrameInput
+class GlfwInput {
+public:
+    GlfwInput();
+
+    FrameInput poll(GLFWwindow* window, float time, float dt);
+
+private:
+    uint64_t lastKeys;
+};
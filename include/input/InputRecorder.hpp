@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include "include/input/FrameInput.hpp"
+
+// Writes one record per frame to a compact binary log that InputReplayer plays back.
+// All values are stored little-endian, as laid out in memory on the supported platforms.
+//
+// Header: "SSIR", uint32 version, uint32 key count (Key::Count when recorded)
+// Frame:  uint8 flags (1 = key events follow, 2 = cursor follows)
+//         float32 time, float32 dt
+//         [uint8 event count, then one uint8 per event: Key index | 0x80 when pressed]
+//         [float64 cursorX, float64 cursorY]
+class InputRecorder {
+public:
+    static constexpr char magic[4] = {'S', 'S', 'I', 'R'};
+    static constexpr uint32_t version = 1;
+    static constexpr uint8_t keyEventsFlag = 1;
+    static constexpr uint8_t cursorFlag = 2;
+    static constexpr uint8_t pressedBit = 0x80;
+
+    InputRecorder();
+
+    bool open(const std::string& path);
+    void write(const FrameInput& input);
+    void close();
+
+    bool isOpen() const { return file.is_open(); }
+    size_t frameCount() const { return frames; }
+
+private:
+    std::ofstream file;
+    uint64_t lastKeys;
+    double lastCursorX;
+    double lastCursorY;
+    size_t frames;
+};
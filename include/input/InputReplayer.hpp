@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "include/input/FrameInput.hpp"
+
+// Plays back a log written by InputRecorder, one recorded frame per call to next().
+// The whole file is read up front so playback does no I/O.
+class InputReplayer {
+public:
+    float fixedDt;   // When > 0, replaces the recorded frame times with a fixed step
+
+    InputReplayer();
+
+    bool open(const std::string& path);
+
+    // Fills in the next frame; false once the recording is exhausted or corrupt
+    bool next(FrameInput& input);
+
+    bool isOpen() const { return opened; }
+    size_t framesPlayed() const { return frames; }
+
+private:
+    bool read(void* value, size_t size);
+
+    std::vector<char> data;
+    size_t offset;
+    FrameInput current;
+    bool opened;
+    size_t frames;
+};
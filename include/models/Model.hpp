@@ -7,9 +7,13 @@
 struct Model {
     std::vector<Mesh> meshes;
 
+    // Assimp post-processing flags used when importing models
+    static const unsigned int importFlags;
+
     void Draw(GLuint shader);
     static Model loadFromFile(const char* path);
 
-private:
-    static void processNode(Model& model, aiNode* node, const aiScene* scene);
+    // Convert the meshes of a node and its children. With uploadToGPU false only the
+    // CPU-side vertex data is built, so no GL context is needed.
+    static void processNode(Model& model, aiNode* node, const aiScene* scene, bool uploadToGPU = true);
 };
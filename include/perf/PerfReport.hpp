@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Measurements of one perf scenario run, summarized into the metrics the
+// performance gate compares against its baseline. Reports are plain text,
+// one "<metric> <value>" pair per line.
+class PerfReport {
+public:
+    struct Metric {
+        std::string name;
+        double value;
+    };
+
+    void addFrame(double frameMs,
+                  unsigned long long drawCalls,
+                  unsigned long long stateChanges,
+                  unsigned long long elidedChanges);
+    void setPeakResidentBytes(size_t bytes) { peakResidentBytes = bytes; }
+    void setGpuFrameMs(double ms) { gpuFrameMs = ms; }
+
+    size_t frameCount() const { return frameMs.size(); }
+
+    // frame_p50/p95/p99/mean_ms, draw_calls, state_changes and state_changes_elided per frame,
+    // peak_rss_mb, gpu_frame_ms
+    std::vector<Metric> summary() const;
+
+    bool write(const std::string& path) const;
+    static bool read(const std::string& path, std::vector<Metric>& metrics);
+
+    // Nearest-rank percentile, p in [0, 100]
+    static double percentile(std::vector<double> values, double p);
+
+private:
+    std::vector<double> frameMs;
+    std::vector<double> drawCalls;
+    std::vector<double> stateChanges;
+    std::vector<double> elidedChanges;   // State calls GLState skipped as redundant
+    size_t peakResidentBytes = 0;
+    double gpuFrameMs = -1.0;   // Negative when the GPU timer queries gave no results
+};
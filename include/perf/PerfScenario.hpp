@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "include/input/FrameInput.hpp"
+#include "include/simulation/SolarSystem.hpp"
+
+// Scripted scene for the performance gate: which system to load, which keys are
+// pressed on which frame and where the camera flies. Frames use a fixed time step,
+// so every run simulates and draws exactly the same frames.
+struct PerfScenario {
+    std::string name;
+    int frameCount;        // Frames to measure
+    int warmupFrames;      // Frames run before measuring (texture uploads, driver warm-up)
+    float dt;              // Fixed frame time fed to the simulation
+    int syntheticBodies;   // Bodies in a SceneGenerator scene, 0 = default solar system
+    bool scriptedCamera;   // Fly the orbit path; false leaves the camera to the scene (planet tours)
+
+    // Scenarios known to the gate: default, tour, blackhole, synthetic_10k, synthetic_100k
+    static const std::vector<std::string>& names();
+    static bool find(const std::string& name, PerfScenario& scenario);
+
+    SolarSystem buildSystem() const;
+
+    // Input for a frame, counted from the first warm-up frame
+    FrameInput input(int frame) const;
+
+    // Camera position and view direction on the flythrough path
+    void cameraPose(int frame, glm::vec3& position, glm::vec3& direction) const;
+
+private:
+    uint64_t keysHeld(int frame) const;
+};
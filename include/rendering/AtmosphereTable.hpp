@@ -0,0 +1,16 @@
+#pragma once
+#include <GL/glew.h>
+#include <vector>
+#include "include/space_objects/Atmosphere.hpp"
+
+// Atmosphere::scattering precomputed for every distinct atmosphere in a scene: one texture
+// row per atmosphere, cos(view angle) from 0 to 1 across. Built once at load time and read
+// by the sphere shader's ATMOSPHERE permutation instead of evaluating scattering per fragment.
+struct AtmosphereTable {
+    GLuint texture;           // RGBA8, 0 when no body has an atmosphere
+    std::vector<float> rows;  // Per body: texture coordinate of its row, negative without an atmosphere
+
+    static constexpr int width = 64;  // Samples per row
+
+    static AtmosphereTable create(const std::vector<Atmosphere>& atmospheres);
+};
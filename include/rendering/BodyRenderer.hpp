@@ -0,0 +1,25 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "include/rendering/CommandBuffer.hpp"
+#include "include/rendering/SphereLods.hpp"
+
+// GL resources and draw packet for a CelestialBody
+struct BodyRenderer {
+    SphereLods spheres;      // Shared sphere meshes, one per level of detail
+    GLuint texture;          // Body's surface texture
+
+    // Factory method to load the surface texture; the meshes come from SceneRenderer
+    static BodyRenderer create(const char* texturePath, const SphereLods& spheres);
+
+    // Record a body with the given world matrix (TransformHierarchy or CelestialBody::getWorldMatrix);
+    // depth is its distance from the camera and level its SphereLods level; shader is the sphere
+    // permutation for its material, and atmosphereRow the body's AtmosphereTable row when that
+    // permutation draws an atmosphere
+    void record(CommandBuffer& commands,
+                const glm::mat4& worldMatrix,
+                GLuint shader,
+                float depth,
+                int level,
+                float atmosphereRow = 0.0f) const;
+};
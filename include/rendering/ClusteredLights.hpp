@@ -0,0 +1,67 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "include/space_objects/StarLight.hpp"
+
+// Clustered light culling. The view frustum is split into screen tiles and exponential depth
+// slices; every frame the lights are binned on the CPU into the clusters their range reaches
+// and the per-cluster lists are uploaded as texture buffers (GL 3.2 has no storage buffers).
+// The lit sphere shaders look up the cluster of each fragment and only loop over its lights,
+// so a star whose light ends a few orbits out costs nothing anywhere else.
+//
+// Texture buffers, bound from bind()'s first unit on:
+//   lights          RGBA32F  position and range, then color, per light
+//   clusterGrid     RG32UI   per cluster: first index into clusterLights, light count
+//   clusterLights   R32UI    light indices, grouped by cluster
+class ClusteredLights {
+public:
+    static constexpr int tilesX = 16;
+    static constexpr int tilesY = 9;
+    static constexpr int slices = 24;
+    static constexpr int clusterCount = tilesX * tilesY * slices;
+    static constexpr int maxLightsPerCluster = 32;   // Further lights reaching a cluster are dropped there
+
+    glm::vec2 tileSize;        // Pixels per tile
+    glm::vec2 depthSlicing;    // slice = log(view depth) * x + y
+    size_t lightCount;         // Lights binned by the last update
+    size_t clusterEntries;     // Light references in the last update's cluster lists
+
+    // Grid for a viewport of the given size and the projection's near and far planes
+    static ClusteredLights create(int width, int height, float nearPlane, float farPlane);
+
+    // Follow a change of the scene's render size (DynamicResolution); the grid keeps its tile count
+    void resize(int width, int height);
+
+    // Bin this frame's lights (main light first) and upload the lists
+    void update(const std::vector<glm::vec3>& positions,
+                const std::vector<StarLight>& lights,
+                const glm::mat4& viewMatrix,
+                const glm::mat4& projectionMatrix);
+
+    // Bind the three buffers to firstUnit, firstUnit + 1 and firstUnit + 2; leaves firstUnit + 2 active
+    void bind(GLenum firstUnit) const;
+
+private:
+    struct Range {
+        int x0, x1, y0, y1, z0, z1;
+        bool visible;
+    };
+
+    // Clusters a light's sphere may touch; false when it lies outside the frustum
+    bool clusterRange(const glm::vec3& viewPosition, float radius, const glm::mat4& projectionMatrix,
+                      Range& range) const;
+    int sliceOf(float depth) const;
+
+    float nearPlane;
+    float farPlane;
+    GLuint buffers[3];         // lights, clusterGrid, clusterLights
+    GLuint textures[3];
+
+    std::vector<glm::vec4> lightData;
+    std::vector<uint32_t> grid;          // Offset and count per cluster
+    std::vector<uint32_t> indices;
+    std::vector<Range> ranges;           // Scratch, per light
+    std::vector<uint32_t> filled;        // Scratch, per cluster
+};
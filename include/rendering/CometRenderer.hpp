@@ -0,0 +1,26 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include "include/rendering/BodyRenderer.hpp"
+#include "include/rendering/CommandBuffer.hpp"
+#include "include/space_objects/TrailPoint.hpp"
+
+// GL resources for a Comet: the head sphere plus the trail line strip
+struct CometRenderer {
+    BodyRenderer head;             // Sphere used for the comet head
+    GLuint trailVAO;               // VAO for trail rendering
+    GLuint trailVBO;               // VBO for trail vertices
+    unsigned int uploadedVersion;  // Comet::trailVersion held by the VBO
+    unsigned int uploadedPoints;   // Number of trail points in the VBO
+
+    // Factory method to create the head and the trail buffers
+    static CometRenderer create(const char* texturePath, const SphereLods& spheres);
+
+    // Upload a comet's trail to its VBO if its version changed since the last upload
+    void updateTrailVBO(const std::vector<TrailPoint>& trail, unsigned int trailVersion);
+
+    // Record the comet's trail for the transparency pass; depth is the head's distance from the camera.
+    // Only the newest fraction of the trail is drawn (QualitySettings::trailFraction).
+    void recordTrail(CommandBuffer& commands, GLuint shader, float depth, float fraction = 1.0f) const;
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// Render passes in submission order
+enum class RenderPass : uint8_t {
+    Opaque = 0,        // Depth tested and written
+    Transparent = 1,   // Weighted blended OIT (TransparencyPass), so drawn in any order
+};
+
+// One draw call with everything it needs bound. Packets carry no GL calls; RenderQueue
+// sorts them by key and issues only the state that changes between neighbours.
+struct DrawPacket {
+    uint64_t key;            // CommandBuffer::sortKey
+    GLuint program;
+    GLuint vao;
+    GLuint texture;          // GL_TEXTURE_2D on unit 0, 0 for none
+    GLenum mode;             // GL_TRIANGLES, GL_LINE_STRIP, ...
+    GLsizei count;           // Indices, or vertices when not indexed
+    bool indexed;            // glDrawElements with GL_UNSIGNED_INT indices
+    bool cull;               // Back-face culling
+    bool lit;                // Receives the frame's light and shadow uniforms
+    float atmosphereRow;     // AtmosphereTable::rows entry, read by ATMOSPHERE sphere permutations
+    glm::mat4 worldMatrix;
+};
+
+// Draw packets recorded for one frame. A buffer is written by one thread at a time, so
+// scene code can record into several buffers in parallel and hand them all to the queue.
+// Buffers keep their capacity across frames.
+class CommandBuffer {
+public:
+    // 64-bit sort key, most significant first:
+    //   pass (4) | program (12) | texture (16) | depth (32), front to back
+    // Depth is the distance from the camera; GL names are truncated, which only affects grouping.
+    // Transparent packets need no back-to-front order, so both passes group by state.
+    static uint64_t sortKey(RenderPass pass, GLuint program, GLuint texture, float depth);
+
+    void clear() { packets.clear(); }
+    void add(const DrawPacket& packet) { packets.push_back(packet); }
+
+    const std::vector<DrawPacket>& items() const { return packets; }
+    size_t size() const { return packets.size(); }
+
+private:
+    std::vector<DrawPacket> packets;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+// Picks the resolution the 3D scene renders at so that GPU frame time stays under a target.
+// Fragment work grows with the pixel count, so the scale (applied to both axes) moves by the
+// square root of the ratio between the target and the measured time. Timings arrive a few
+// frames late (GpuProfiler::framesInFlight), so after each change the controller waits for
+// frames rendered at the new size before judging it. Overlays are unaffected: the scene is
+// upscaled into the window (TransparencyPass::present) and the UI drawn over it.
+class DynamicResolution {
+public:
+    static constexpr float minScale = 0.5f;
+    static constexpr float maxScale = 1.0f;
+
+    float targetMs;       // GPU frame time to stay under; 0 keeps the full resolution
+    float scale;          // Current fraction of the full width and height
+    float scaleLimit;     // Largest scale to go back up to (QualitySettings::renderScaleLimit)
+    float averageMs;      // Smoothed GPU frame time
+    int renderWidth;      // Scene size at the current scale
+    int renderHeight;
+
+    // Full resolution, scaled down only when frames go over targetMs
+    static DynamicResolution create(int width, int height, float targetMs);
+
+    // Feed the newest GPU frame time (GpuProfiler::lastFrameMs, once per new sample);
+    // true when renderWidth and renderHeight changed
+    bool update(float gpuFrameMs);
+
+    // Cap the scale, dropping to the cap right away if above it; true when the render size changed
+    bool setScaleLimit(float limit);
+
+private:
+    void applyScale(float newScale);
+    bool resize(float newScale);   // applyScale, then wait for timings at the new size if it changed
+
+    int fullWidth;
+    int fullHeight;
+    int settleFrames;     // Samples to skip until frames at the current size come back
+};
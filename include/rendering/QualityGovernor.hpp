@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Trades detail for frame time. Registered knobs (QualitySettings fields) move in steps
+// between a best and a worst value; the governor collects a window of frame times and
+// looks at their 90th percentile. Over the budget, it lowers the first knob that isn't at
+// its worst yet; well under the budget, it raises the last lowered one again. After each
+// change it starts a new window, and a knob that had to be lowered again straight after
+// being raised doubles the wait before the next raise (halved again by each raise that holds),
+// so quality doesn't oscillate around the budget. Every change is logged to the console.
+class QualityGovernor {
+public:
+    static constexpr int windowFrames = 60;     // Frames per decision
+    static constexpr float raiseBelow = 0.7f;   // Fraction of the budget under which quality goes back up
+    static constexpr int maxRaiseWait = 8;      // Longest backoff, in windows
+
+    float budgetMs;      // Frame time to hold; 0 leaves every knob at its best
+
+    explicit QualityGovernor(float budgetMs);
+
+    // Knobs are lowered in the order they are added and raised in reverse; value starts at best
+    void addKnob(const std::string& name, float& value, float best, float worst, float step);
+
+    // Replace a knob's bounds, clamping its value; false if there is no knob of that name
+    bool setBounds(const std::string& name, float best, float worst);
+
+    // One frame's time (the slower of its CPU and GPU work); true when a knob changed
+    bool addSample(float frameMs);
+
+private:
+    struct Knob {
+        std::string name;
+        float* value;
+        float best;
+        float worst;
+        float step;      // Positive; applied towards worst or best
+    };
+
+    bool lower(float percentileMs);
+    bool raise(float percentileMs);
+    static bool atWorst(const Knob& knob);
+    static bool atBest(const Knob& knob);
+
+    std::vector<Knob> knobs;
+    std::vector<float> samples;
+    int raiseWait;          // Windows under the budget needed before a raise
+    int windowsUnder;       // Consecutive windows under the budget so far
+    int lastRaised;         // Knob raised by the last decision, -1 if it wasn't a raise
+};
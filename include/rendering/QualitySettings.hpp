@@ -0,0 +1,19 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include "include/simulation/SolarSystem.hpp"
+
+// Detail the renderer draws at. The defaults are full quality; QualityGovernor lowers and
+// raises them at run time to hold a frame budget. Knobs are floats so the governor can step
+// them alike; counts are rounded down where they are used.
+struct QualitySettings {
+    float sphereLodBias = 0.0f;      // SphereLods::levelFor bias; higher picks coarser spheres sooner
+    float trailFraction = 1.0f;      // Newest part of each comet trail that is drawn
+    float shadowCasters = static_cast<float>(SolarSystem::maxShadowCasters);  // Occluders a shadowed fragment tests
+    float renderScaleLimit = 1.0f;   // Largest scale DynamicResolution may pick
+
+    // Shadow casters to use out of the available ones, 0 for the unshadowed permutations
+    size_t shadowCasterCount(size_t available) const {
+        return std::min(available, static_cast<size_t>(std::max(shadowCasters, 0.0f)));
+    }
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "include/rendering/CommandBuffer.hpp"
+#include "include/utils/GpuProfiler.hpp"
+
+class ClusteredLights;
+struct TransparencyPass;
+
+// Uniforms shared by every packet of a frame, set once per program
+struct FrameUniforms {
+    glm::mat4 viewMatrix;
+    glm::mat4 projectionMatrix;
+    glm::vec3 viewPos;
+    const std::vector<glm::vec3>* shadowPositions;   // Lit packets only
+    const std::vector<float>* shadowRadii;
+    size_t shadowCasters;                            // How many of them to test, QualitySettings::shadowCasterCount
+    GLuint atmosphereTable;                          // AtmosphereTable::texture, bound to unit 1
+    const ClusteredLights* lights;                   // Updated for this frame, bound to units 2-4
+};
+
+// Backend for CommandBuffers: the single point where scene draws reach GL. Merges the
+// buffers recorded for a frame, sorts their packets by key and submits them pass by pass.
+// Sorting puts packets sharing a program and texture next to each other, so GLState's
+// shadow cache skips most binds. Uniform locations are looked up once per program.
+// Translucent packets go through a TransparencyPass, which needs no back-to-front order.
+class RenderQueue {
+public:
+    size_t submittedPackets;   // Packets drawn by the last submit
+
+    RenderQueue();
+
+    // Queue a buffer for the next submit; it must stay unchanged until then
+    void add(const CommandBuffer& buffer);
+
+    // Draw everything queued, then forget it. Leaves culling on and blending off, with the
+    // usual (source alpha, one minus source alpha) blend function for later overlays.
+    void submit(const FrameUniforms& frame, GpuProfiler& gpuProfiler, const TransparencyPass& transparency);
+
+private:
+    struct SortEntry {
+        uint64_t key;
+        uint32_t buffer;
+        uint32_t index;
+    };
+
+    struct ProgramUniforms {
+        GLuint program;
+        GLint worldMatrix;
+        GLint viewMatrix;
+        GLint projectionMatrix;
+        GLint texture1;
+        GLint lights;
+        GLint clusterGrid;
+        GLint clusterLights;
+        GLint clusterCounts;
+        GLint clusterTileSize;
+        GLint clusterDepthSlicing;
+        GLint viewPos;
+        GLint planetPositions;
+        GLint planetRadii;
+        GLint numPlanets;
+        GLint atmosphereTable;
+        GLint atmosphereRow;
+        float atmosphereRowValue;   // Last value set this frame, negative for none
+        bool frameSet;         // Frame uniforms set this frame
+        bool litSet;           // Light and shadow uniforms set this frame
+    };
+
+    ProgramUniforms& uniformsFor(GLuint program);
+
+    std::vector<const CommandBuffer*> buffers;
+    std::vector<SortEntry> entries;
+    std::vector<ProgramUniforms> programs;
+};
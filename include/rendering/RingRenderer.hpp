@@ -0,0 +1,19 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "include/rendering/CommandBuffer.hpp"
+#include "include/space_objects/PlanetRing.hpp"
+
+// GL resources and draw packet for a PlanetRing
+struct RingRenderer {
+    GLuint vao;
+    GLuint texture;
+    unsigned int indexCount;
+
+    // Factory method to upload the ring geometry and load its texture
+    static RingRenderer create(const PlanetRing& ring, const char* texturePath);
+
+    // Record the planet ring at its world matrix (PlanetRing::getWorldMatrix); translucent and
+    // visible from both sides
+    void record(CommandBuffer& commands, const glm::mat4& worldMatrix, GLuint shader, float depth) const;
+};
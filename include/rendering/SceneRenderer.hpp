@@ -0,0 +1,52 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+#include "include/rendering/AtmosphereTable.hpp"
+#include "include/rendering/BodyRenderer.hpp"
+#include "include/rendering/CometRenderer.hpp"
+#include "include/rendering/CommandBuffer.hpp"
+#include "include/rendering/QualitySettings.hpp"
+#include "include/rendering/RenderQueue.hpp"
+#include "include/rendering/RingRenderer.hpp"
+#include "include/rendering/SphereLods.hpp"
+#include "include/simulation/SolarSystem.hpp"
+#include "include/utils/WorkerPool.hpp"
+#include "include/world/SceneSnapshot.hpp"
+#include "include/world/ShaderPrograms.hpp"
+
+// GL resources for everything in a SolarSystem. Bodies sharing a surface texture
+// share one BodyRenderer, so large generated scenes don't load a texture per body,
+// and all bodies share one set of sphere meshes. Records from a SceneSnapshot, so it can run on a render
+// thread while the system itself moves on.
+struct SceneRenderer {
+    std::vector<BodyRenderer> bodyRenderers;   // One per distinct texture path
+    std::vector<int> bodyRendererIndex;        // Per body: index into bodyRenderers
+    std::vector<CometRenderer> cometRenderers; // Parallel to SolarSystem::comets
+    std::vector<RingRenderer> ringRenderers;   // Parallel to SolarSystem::rings
+    std::vector<bool> emissive;                // Copy of SolarSystem::emissive
+    std::vector<int> ringPlanets;              // Copy of SolarSystem::ringPlanets
+    AtmosphereTable atmospheres;               // Scattering of SolarSystem::atmospheres, one row each
+    SphereLods spheres;                        // Meshes for bodies and comet heads
+    float pixelScale;                          // Screen radius in pixels of a unit sphere at distance 1, for LOD
+
+    std::vector<CommandBuffer> bodyCommands;   // One per recording thread, reused every frame
+    CommandBuffer ringCometCommands;           // Rings, comet trails and heads
+    std::unique_ptr<WorkerPool> workers;       // Recording threads, started by the first large scene
+
+    static constexpr size_t parallelRecordBodies = 16384; // Visible bodies from which recording is split across threads
+
+    // pixelScale is 0.5 * viewport height * projectionMatrix[1][1]
+    static SceneRenderer create(const SolarSystem& solarSystem, float pixelScale);
+
+    // Upload changed comet trails and record visible bodies, their rings and the comets into the
+    // queue. Each draw gets the sphere permutation for its material: the sun variant for emissive
+    // bodies, atmosphere for bodies that have one, shadows only when the snapshot has shadow
+    // casters and quality allows some, and the sphere level for its size on screen. Large scenes
+    // record bodies on several threads of a pool kept across frames, one CommandBuffer each.
+    void record(const SceneSnapshot& snapshot,
+                const ShaderPrograms& shaders,
+                const QualitySettings& quality,
+                RenderQueue& queue);
+};
@@ -0,0 +1,18 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "include/space_objects/CelestialBody.hpp"
+
+// Wireframe sphere drawn around the planet picked in planet selection mode
+struct SelectionRenderer {
+    GLuint vao;              // Sphere drawn in wireframe around the selection
+    unsigned int indexCount;
+
+    static SelectionRenderer create();
+
+    // Render selection indicator around the given body
+    void render(const CelestialBody& selectedBody,
+                GLuint shader,
+                const glm::mat4& viewMatrix,
+                const glm::mat4& projectionMatrix) const;
+};
@@ -0,0 +1,17 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+// Uploads position/UV meshes (spheres, rings) into a VAO:
+// positions at attribute 0, UVs at attribute 1, plus an index buffer
+class SphereBuffers {
+public:
+    static GLuint setupSphereBuffers(const std::vector<glm::vec3>& vertices,
+                                    const std::vector<glm::vec2>& uvs,
+                                    const std::vector<unsigned int>& indices);
+                                    
+    static GLuint createTexturedSphereVAO(unsigned int rings,
+                                         unsigned int sectors,
+                                         unsigned int& indexCount);
+};
@@ -0,0 +1,21 @@
+#pragma once
+#include <GL/glew.h>
+
+// UV spheres at decreasing tessellation, uploaded once and shared by every body. Each draw
+// picks a level from the body's radius on screen, so distant planets and asteroids don't
+// pay for the full 40x40 mesh. A positive bias (QualitySettings::sphereLodBias) switches
+// to coarser levels while bodies are still larger on screen.
+struct SphereLods {
+    static constexpr int levels = 4;
+    static constexpr unsigned int segments[levels] = {40, 28, 18, 10};          // Rings and sectors
+    static constexpr float minPixelRadius[levels] = {48.0f, 16.0f, 6.0f, 0.0f}; // Smallest screen radius per level
+
+    GLuint vaos[levels];
+    unsigned int indexCounts[levels];
+
+    static SphereLods create();
+
+    // Level for a sphere of this screen radius in pixels; each unit of bias doubles the radius
+    // needed for the finer levels
+    static int levelFor(float pixelRadius, float bias);
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <GL/glew.h>
+
+// Weighted blended order-independent transparency (McGuire and Bavoil). The 3D scene is
+// drawn into an offscreen target; translucent surfaces are then added, in any order, to two
+// more targets that share its depth buffer:
+//   accumulation (RGBA16F)  rgb: sum of color * alpha * weight, a: product of (1 - alpha)
+//   weight (R16F)           sum of alpha * weight
+// composite() blends their weighted average over the scene. One blend function serves both
+// targets, so GL 3.2 without per-buffer blending is enough. Weights favour nearby surfaces;
+// the shaders compute them (OIT in textured_sphere.frag.glsl, trail.frag.glsl).
+//
+// The scene may use only the lower-left renderWidth x renderHeight of the targets
+// (DynamicResolution); present() scales that part up to the whole window.
+struct TransparencyPass {
+    GLuint sceneFramebuffer;        // Opaque scene, composited result
+    GLuint sceneColor;
+    GLuint depthBuffer;             // Shared by both framebuffers
+    GLuint transparentFramebuffer;  // accumulation and weight
+    GLuint accumulation;
+    GLuint weight;
+    GLuint emptyVAO;                // Core profile draws need a VAO, even for a generated triangle
+    GLuint compositeShader;
+    int width;                      // Size of the targets and the window
+    int height;
+    int renderWidth;                // Part the scene draws into
+    int renderHeight;
+    bool complete;                  // False: the scene draws straight to the window, without translucent surfaces
+
+    // Targets of the given size; compositeShader only has to be usable by the first composite()
+    static TransparencyPass create(int width, int height, GLuint compositeShader);
+
+    // Draw the scene into this much of the targets, from the next beginScene() on; ignored
+    // without usable targets, since the window can't be scaled up into itself
+    void setRenderSize(int renderWidth, int renderHeight);
+
+    // Draw the 3D scene offscreen from here on, at the render size; the caller clears
+    void beginScene() const;
+
+    // Clear the transparency targets and set up accumulation: additive blending, depth test
+    // against the opaque scene without writing depth. False if the targets are unusable.
+    bool beginTransparent() const;
+
+    // Blend the accumulated surfaces over the scene and restore opaque drawing state; only
+    // after a successful beginTransparent()
+    void composite() const;
+
+    // Copy the scene into the window's framebuffer, scaled up to fill it, and draw there at the
+    // full size from here on (UI, overlays)
+    void present() const;
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "include/utils/MappedFile.hpp"
+
+// Piecewise Chebyshev ephemeris: the record layout of JPL DE files, repacked into a
+// compact little-endian binary (tools/ephemeris_gen.cpp writes it). The file is
+// memory-mapped; opening reads only the header and body table, and evaluating a date
+// touches just the page holding that date's coefficients.
+//
+//   header  "SSEP", u32 version, u32 bodyCount, u32 reserved, f64 startJd, f64 endJd
+//   bodies  bodyCount x { char name[16], i32 center, u32 coefficientCount, f64 granuleDays,
+//                         u32 granuleCount, u32 reserved, u64 offset }
+//   data    per body, granuleCount x { x[coefficientCount], y[...], z[...] } as f64
+//
+// Positions are in AU on the J2000 ecliptic, relative to the center body (-1 = the Sun).
+class Ephemeris {
+public:
+    static constexpr uint32_t version = 1;
+    static constexpr uint32_t maxCoefficients = 32;
+
+    struct Body {
+        std::string name;           // Lower-case, matches SolarSystem::names
+        int center;                 // Index of the body this one is relative to, -1 = the Sun
+        uint32_t coefficientCount;  // Per axis and granule
+        double granuleDays;         // Length of the interval each coefficient set covers
+        uint32_t granuleCount;
+        uint64_t offset;            // Byte offset of the first granule
+    };
+
+    // Input for write: granuleCount * 3 * coefficientCount values, granules starting at startJd
+    struct BodyTable {
+        Body body;
+        std::vector<double> coefficients;
+    };
+
+    Ephemeris() = default;
+    Ephemeris(const Ephemeris&) = delete;
+    Ephemeris& operator=(const Ephemeris&) = delete;
+
+    bool open(const std::string& path);
+
+    int findBody(const std::string& name) const;
+    const std::vector<Body>& bodyList() const { return bodies; }
+    double startJd() const { return start; }
+    double endJd() const { return end; }
+
+    // Position relative to the body's center at a Julian date, clamped to the covered range
+    glm::dvec3 position(int body, double julianDate) const;
+
+    static bool write(const std::string& path, double startJd, double endJd, const std::vector<BodyTable>& tables);
+
+    // Julian date at 0h UT of a Gregorian calendar date
+    static double julianDate(int year, int month, int day);
+    // "YYYY-MM-DD"
+    static bool parseDate(const std::string& text, double& julianDate);
+    static std::string formatDate(double julianDate);
+
+private:
+    MappedFile file;
+    std::vector<Body> bodies;
+    double start = 0.0;
+    double end = 0.0;
+};
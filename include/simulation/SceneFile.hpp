@@ -0,0 +1,27 @@
+#pragma once
+#include <string>
+#include "include/simulation/SolarSystem.hpp"
+
+// Text scene format loaded by the app (--scene) and written by solarscope_scenegen.
+// One record per line, whitespace-separated, '#' starts a comment. Parents must be
+// listed before their children; names and texture paths can't contain spaces.
+//
+//   body <name> <parent|-> <emissive 0|1> <scale> <orbitRadius> <orbitSpeed> <orbitPhase> <rotationSpeed> <x> <y> <z> <texture>
+//   ring <body> <innerRadius> <outerRadius> <segments> <tilt> <texture>
+//   comet <centerX> <centerY> <centerZ> <semiMajorAxis> <eccentricity> <startAngle> <maxTrailPoints> <texture>
+//   atmosphere <body> <r> <g> <b> <thickness> <rayleighR> <rayleighG> <rayleighB> <mie>
+//   light <body> <r> <g> <b> <range>
+//
+// x y z is the starting position and only matters for bodies without a parent. Bodies
+// without an atmosphere record have none (see Atmosphere); version 1 files had no such record.
+// light records set the light of emissive bodies (StarLight); without one it is StarLight::standard(),
+// as in version 2 files.
+class SceneFile {
+public:
+    static constexpr int version = 3;
+
+    // Replaces the contents of system; reports the offending line and returns false on errors
+    static bool load(const std::string& path, SolarSystem& system);
+
+    static bool save(const std::string& path, const SolarSystem& system);
+};
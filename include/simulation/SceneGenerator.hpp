@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include "include/simulation/SolarSystem.hpp"
+
+// Procedural scenes for scaling tests: a star with planets, nested moons, ringed
+// planets, comets, an asteroid belt and companion stars. The same options and seed always give the
+// same scene, on every platform (the generator doesn't use <random> distributions,
+// whose output differs between standard libraries).
+class SceneGenerator {
+public:
+    struct Options {
+        uint32_t seed = 1;
+        int planets = 8;
+        int moonsPerBody = 1;       // Moons around each planet, and around each moon above moonDepth
+        int moonDepth = 1;          // 1 = moons only, 2 = moons of moons, ...
+        int ringedPlanets = 1;      // Planets that get a ring, picked at random
+        int comets = 2;
+        int maxTrailPoints = 150;   // Trail length per comet
+        int asteroids = 0;          // Small bodies in a belt between the planets
+        int companionStars = 0;     // Extra stars orbiting the main one (binary, trinary systems)
+        float innerOrbit = 8.0f;    // Planet orbit radii are spread over [innerOrbit, outerOrbit]
+        float outerOrbit = 60.0f;
+    };
+
+    static SolarSystem generate(const Options& options);
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+
+// Fixed-timestep clock. Each frame adds its wall time to an accumulator and the
+// simulation runs as many whole steps as fit, so simulated state depends only on the
+// sequence of frame times, not on how fast frames render:
+//
+//     clock.beginFrame(dt);
+//     while (clock.step()) { ...advance one stepSeconds... }
+//     render at alpha() of the way from the previous step to the last one
+//
+// A frame runs at most maxStepsPerFrame steps; time beyond that is dropped so a slow
+// frame cannot snowball into ever slower frames (spiral of death).
+class SimulationClock {
+public:
+    static constexpr double defaultStepSeconds = 1.0 / 60.0;
+    static constexpr int defaultMaxStepsPerFrame = 8;
+
+    double stepSeconds;       // Simulated wall time per step
+    int maxStepsPerFrame;     // Steps beyond this in one frame are dropped
+
+    SimulationClock();
+
+    void beginFrame(float frameSeconds);
+
+    // True while another step is due this frame; advances time() by one step
+    bool step();
+
+    // Clock time at the last step taken: stepCount() * stepSeconds
+    double time() const { return steps * stepSeconds; }
+    uint64_t stepCount() const { return steps; }
+
+    // Fraction of a step accumulated since the last one, in [0, 1)
+    float alpha() const { return static_cast<float>(accumulator / stepSeconds); }
+
+    // Wall time thrown away by the step cap since the clock started
+    double droppedSeconds() const { return dropped; }
+
+private:
+    double accumulator;
+    uint64_t steps;
+    int stepsThisFrame;
+    double dropped;
+};
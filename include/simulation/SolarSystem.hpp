@@ -0,0 +1,128 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "include/simulation/Ephemeris.hpp"
+#include "include/simulation/TransformHierarchy.hpp"
+#include "include/simulation/UpdateScheduler.hpp"
+#include "include/space_objects/Atmosphere.hpp"
+#include "include/space_objects/BlackHole.hpp"
+#include "include/space_objects/CelestialBody.hpp"
+#include "include/space_objects/Comet.hpp"
+#include "include/space_objects/PlanetRing.hpp"
+#include "include/space_objects/StarLight.hpp"
+
+// Simulation state of the whole scene: bodies, comets, rings and the black hole
+// effect. Holds no GL resources, so headless tools can step it without a window.
+// Bodies are stored parent-first; per-body data lives in parallel arrays.
+class SolarSystem {
+public:
+    static constexpr int maxShadowCasters = 9;  // MAX_PLANETS in textured_sphere.frag.glsl
+
+    std::vector<CelestialBody> bodies;
+    std::vector<std::string> names;          // Lower-case body names ("sun", "earth", ...)
+    std::vector<std::string> texturePaths;   // Surface texture per body, used by the renderer
+    std::vector<int> parents;                // Index of the body orbited, -1 for none
+    std::vector<bool> emissive;              // Stars: lit from inside, never cast shadows
+    std::vector<Atmosphere> atmospheres;     // Atmosphere::none() for stars and airless bodies
+    std::vector<StarLight> lights;           // Light of each emissive body; ignored for the rest
+    TransformHierarchy transforms;           // One node per body, same index; world matrices for rendering
+    UpdateScheduler scheduler;               // Which orbits are evaluated each frame (simulation LOD)
+
+    std::vector<Comet> comets;
+    std::vector<std::string> cometTexturePaths;
+
+    std::vector<PlanetRing> rings;
+    std::vector<int> ringPlanets;            // Body index each ring belongs to
+    std::vector<std::string> ringTexturePaths;
+
+    static constexpr double orbitDegreesPerSecond = 20.0;  // Shared orbital angle speed, scaled per body
+    static constexpr double ephemerisDaysPerSecond = 365.25 / 18.0; // Earth keeps its 18 s year
+
+    // Ephemeris mode: bodies found in the table follow their real positions for the date
+    std::shared_ptr<const Ephemeris> ephemeris;
+    std::vector<int> ephemerisBodies;        // Table index per body, -1 for the simulated orbit
+    std::vector<float> ephemerisScales;      // Display units per AU, keeps each mean distance at orbitRadius
+    double ephemerisEpochJd;                 // Julian date at simulation time 0
+
+    BlackHole blackHole;
+    double simulationTime; // Simulated seconds; every orbit and spin is a function of it
+    bool comparisonMode;   // Planets lined up by size instead of orbiting
+
+    SolarSystem();
+
+    // Sun, eight planets, the Moon, Saturn's rings and two comets
+    static SolarSystem createDefault();
+
+    // Append a body; parents must be added before their children
+    int addBody(const std::string& name,
+                const std::string& texturePath,
+                const CelestialBody& body,
+                int parent,
+                bool isEmissive = false,
+                const Atmosphere& atmosphere = Atmosphere::none());
+
+    int findBody(const std::string& name) const;
+    bool isVisible(int index) const { return bodies[index].scale.x > 0.01f; }
+
+    // Position of the main light source (first emissive body)
+    glm::vec3 lightPosition() const;
+
+    // Every emissive body's position and light, main light first
+    void collectLights(std::vector<glm::vec3>& positions, std::vector<StarLight>& lightSources) const;
+
+    // Step bodies and comets; currentTime is clock time (SimulationClock) and drives comet trails
+    // and the black hole animation, elapsedSeconds is the clock time since the previous update.
+    // Negative animationDt runs time backwards along exactly the same orbits.
+    void update(float animationDt, float currentTime, float elapsedSeconds);
+    void updateBodies(float animationDt, float currentTime);
+    void updateComets(float currentTime, float elapsedSeconds);
+
+    // One fixed simulation step: advance time and comet trails (left alone when paused, animationDt 0),
+    // leaving bodies where they are
+    void step(float animationDt, float currentTime, float elapsedSeconds);
+
+    // Place bodies and comet heads at a time without advancing the simulation. Everything
+    // placed here is a function of time, so rendering between two steps poses at the time in
+    // between rather than blending the two states.
+    void poseBodies(double time, float currentTime);
+
+    // Recompute body positions and transforms after simulation state was set directly (StateHistory)
+    void refreshBodies(float currentTime);
+
+    // Jump straight to a simulation time; costs one frame however far the jump. Comet trails restart.
+    void seek(double time, float currentTime);
+
+    // Shared orbital angle in degrees at the current simulation time (not reduced)
+    double orbitalAngle() const { return orbitDegreesPerSecond * simulationTime; }
+
+    // Drive every body whose name and parent match an ephemeris entry from the table, with
+    // simulation time 0 at epochJd. Returns false if no body matched.
+    bool attachEphemeris(std::shared_ptr<const Ephemeris> table, double epochJd);
+    double julianDate() const { return julianDateAt(simulationTime); }
+    double julianDateAt(double time) const { return ephemerisEpochJd + time * ephemerisDaysPerSecond; }
+
+    // Spread planets around their orbits and remember the layout for resetBlackHole
+    void placeInitialOrbits();
+
+    void activateBlackHole(float currentTime);
+    void resetBlackHole();
+
+    // Positions and radii of the bodies the lit shader tests for shadows (none in comparison mode)
+    void collectShadowCasters(std::vector<glm::vec3>& positions, std::vector<float>& radii) const;
+
+private:
+    void updateOrbits(double time);
+    void evaluateOrbit(int index, double time, double baseAngle, double jd);
+    void updateBlackHole(float currentTime);
+    void updateComparisonLayout(double time);
+    glm::vec3 ephemerisOffset(int index, double jd) const;
+
+    // Feed body positions set directly (black hole, comparison, reset) into the hierarchy
+    void syncTransforms();
+
+    double posedTime;      // Time the orbits were last evaluated for
+    bool orbitsUpToDate;   // False forces every orbit to be evaluated on the next pass
+    std::vector<int> dueBodies;   // Scratch: bodies the scheduler picked
+};
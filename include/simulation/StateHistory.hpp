@@ -0,0 +1,102 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "include/simulation/SolarSystem.hpp"
+
+// Time-travel buffer for reverse playback and scrubbing. Records the part of the
+// simulation that cannot be recomputed from simulationTime (comet trails, black hole
+// state, comparison mode, where the unorbiting root bodies sit) once per frame, and restores it for any recorded time.
+//
+// Every keyframeInterval frames a keyframe stores a full state; the frames in between
+// store only the XOR of each 32-bit word with a prediction from the previous frame: the
+// same value, or for trails the previous point shifted along and aged by one step. Most
+// residuals are zero or a few low mantissa bytes, and blocks of eight zero words cost one
+// byte. Restoring decodes the nearest keyframe and rolls forward through the deltas, so
+// it costs at most keyframeInterval decodes however far back it goes. The oldest
+// keyframe and its deltas are dropped when the buffer exceeds budgetBytes.
+class StateHistory {
+public:
+    static constexpr int keyframeInterval = 60;
+
+    size_t budgetBytes;   // Memory for encoded frames; at least the newest keyframe is always kept
+
+    StateHistory();
+
+    // Append the state after a frame. Simulation time must not go backwards (clear first).
+    void record(const SolarSystem& system, float currentTime);
+
+    // Restore the newest frame at or before time. currentTime rebases the wall-clock
+    // timers (trail spacing, black hole animation) so playback continues smoothly from it.
+    // Returns false if nothing was recorded.
+    bool restore(double time, SolarSystem& system, float currentTime);
+
+    // Drop every frame after the last restored one, so recording continues from there
+    void discardAfterRestored();
+
+    void clear();
+
+    bool empty() const { return segments.empty(); }
+    double oldestTime() const { return segments.front().frames.front().simulationTime; }
+    double newestTime() const { return segments.back().frames.back().simulationTime; }
+    size_t frameCount() const;
+    size_t memoryBytes() const { return storedBytes; }
+
+private:
+    // Decoded state of one frame: 32-bit words laid out as black hole strength and
+    // activation time, root body positions, body rotations (while the black hole holds
+    // them), the black hole's captured positions and scales, then per comet the last trail
+    // time and its points
+    struct Snapshot {
+        double simulationTime = 0.0;
+        float currentTime = 0.0f;
+        uint32_t flags = 0;                  // 1 = comparison mode, 2 = black hole active
+        uint32_t rootWords = 0;
+        uint32_t rotationWords = 0;
+        uint32_t originalWords = 0;
+        std::vector<uint32_t> trailSizes;    // Points per comet
+        std::vector<uint32_t> words;
+    };
+
+    struct Frame {
+        double simulationTime;
+        size_t offset;   // Into the segment's bytes
+    };
+
+    // A keyframe and the deltas that follow it
+    struct Segment {
+        uint64_t id;
+        std::vector<unsigned char> bytes;
+        std::vector<Frame> frames;
+    };
+
+    static void capture(const SolarSystem& system, float currentTime, Snapshot& snapshot);
+    static void apply(const Snapshot& snapshot, SolarSystem& system, float currentTime);
+
+    // previous == nullptr encodes a keyframe
+    void encode(const Snapshot& current, const Snapshot* previous, std::vector<unsigned char>& out);
+    void decode(const unsigned char* bytes, const Snapshot* previous, Snapshot& out);
+    // Fill reference for a frame laid out like layout, from shifts and ageSteps
+    void predict(const Snapshot* previous, const Snapshot& layout);
+
+    bool locate(double time, size_t& segment, size_t& frame) const;
+    void evictOldest();
+
+    std::deque<Segment> segments;
+    uint64_t nextSegmentId;
+    size_t storedBytes;
+    int framesSinceKeyframe;
+
+    Snapshot newest;        // Reference for the next delta
+    Snapshot scratch;
+    Snapshot decoded;       // Last restored frame, so stepping forward does not start at the keyframe
+    uint64_t decodedSegmentId;
+    size_t decodedFrame;
+    bool hasDecoded;
+    bool showingDecoded;    // The system was last set from decoded and nothing was recorded since
+
+    std::vector<uint32_t> reference;   // Predicted words for the frame being coded
+    std::vector<int> shifts;           // Per comet: trail points added since the previous frame
+    std::vector<float> ageSteps;       // Per comet: age added to each surviving trail point
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Parent-first flat transform hierarchy. Each node has a local translation, a yaw
+// about +Y and a scale; a node's world translation is its parent's world translation
+// plus its local one (children follow their parent's position but not its spin or
+// size, as a moon follows its planet). World matrices are composed in closed form,
+// T * Ry * S, only for nodes whose own transform or ancestor position changed.
+class TransformHierarchy {
+public:
+    std::vector<int> parents;                  // Parent node, -1 for none; always lower than the child's index
+    std::vector<glm::vec3> localTranslations;  // Relative to the parent's world translation, or absolute
+    std::vector<float> yaws;                   // Rotation about +Y in degrees
+    std::vector<glm::vec3> scales;             // Per-axis scale; negative axes mirror
+    std::vector<uint8_t> relative;             // 0 when localTranslation is absolute for this frame
+    std::vector<glm::vec3> worldTranslations;
+    std::vector<glm::mat4> worldMatrices;
+
+    // Append a node; the parent must already exist
+    int add(int parent);
+
+    size_t size() const { return parents.size(); }
+
+    // Marks the node dirty only when something actually changed
+    void setLocal(int index,
+                  const glm::vec3& translation,
+                  float yawDegrees,
+                  const glm::vec3& scale,
+                  bool isRelative = true);
+
+    // One linear pass for world translations, then matrix composition for dirty nodes in blocks
+    // whose trig and column arithmetic the compiler vectorizes (-O3, as in Release builds).
+    // Returns the number of world matrices recomposed.
+    size_t update();
+
+    // Nodes recomposed by the last update
+    const std::vector<int>& updatedNodes() const { return dirtyNodes; }
+
+    const glm::vec3& worldTranslation(int index) const { return worldTranslations[index]; }
+    const glm::mat4& worldMatrix(int index) const { return worldMatrices[index]; }
+
+    // T * Ry(yaw) * S without building and multiplying the three matrices
+    static glm::mat4 compose(const glm::vec3& translation, float yawDegrees, const glm::vec3& scale);
+
+private:
+    std::vector<uint8_t> dirty;         // Local transform changed since the last update
+    std::vector<uint8_t> moved;         // World translation changed in the current update
+    std::vector<int> dirtyNodes;        // Scratch: nodes whose matrix is recomposed
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class SolarSystem;
+
+// Simulation level of detail: picks the bodies whose orbits are evaluated on a frame.
+// Each body gets an update period from its screen coverage and importance:
+//   - stars, root bodies, shadow casters, ringed planets and the focus body: every frame
+//   - on screen: every frame from fullRatePixels of radius up, every 2nd, 4th, ... frame when smaller
+//   - off screen: round-robin from a cursor, a 1/offscreenPeriod share of them per frame,
+//     cut short when it would take more than budgetMicroseconds
+// A parent takes the shortest period of its children, which hang off its position.
+// Orbits are closed-form in simulation time, so a body that was skipped is exact again as
+// soon as it is evaluated. Skipped bodies are tested with a sphere grown by the distance they
+// can have travelled since their last evaluation, so one that moved on screen is evaluated
+// that same frame rather than after its off-screen turn comes round.
+class UpdateScheduler {
+public:
+    bool enabled;                  // false evaluates every body every frame
+    size_t minBodies;              // Smaller scenes always evaluate everything
+    float fullRatePixels;          // Screen radius from which a body updates every frame
+    int maxVisiblePeriod;          // Longest period for a body on screen; a power of two
+    int offscreenPeriod;           // Frames to cycle through every off-screen body
+    double budgetMicroseconds;     // Off-screen work per frame; 0 = no limit, so runs stay deterministic
+    int focus;                     // Body the camera follows, -1 for none
+
+    UpdateScheduler();
+
+    // Camera for the following plans. Until a view is set, every body is evaluated.
+    void setView(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, float viewportHeight);
+
+    // Evaluate everything on the next plan (jumps, restored or directly placed bodies)
+    void invalidate() { planAll = true; }
+
+    // Bodies to evaluate at time. Assumes the caller evaluates all of them.
+    void plan(const SolarSystem& system, double time, std::vector<int>& due);
+
+    // Report how long the planned evaluation took; keeps the per-body cost for the budget
+    void finish(size_t evaluated, double microseconds);
+
+    // Bodies left at an older time by the last plan
+    size_t staleBodies() const { return staleCount; }
+
+    // Bodies the last plan found on screen
+    size_t visibleBodies() const { return visibleCount; }
+
+private:
+    glm::mat4 viewProjection;
+    float pixelScale;              // Screen radius in pixels of a unit sphere at unit depth
+    float clipScale;               // Clip-space radius of a unit sphere at unit depth
+    bool hasView;
+    bool planAll;
+
+    uint64_t frame;
+    size_t cursor;                 // Next off-screen body in the round-robin
+    size_t staleCount;
+    size_t visibleCount;
+    double nanosecondsPerBody;     // Running average of the evaluation cost
+
+    std::vector<double> posedTimes;  // Time each body was last evaluated at
+    std::vector<float> drifts;       // Scratch: how far each body may be from its stored position
+    std::vector<int> periods;        // 0 = off screen
+    std::vector<uint8_t> wasVisible;
+    std::vector<int> pinned;         // Bodies updated every frame whatever the camera sees
+};
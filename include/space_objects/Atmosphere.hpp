@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+#include <glm/glm.hpp>
+
+// Optical properties of a body's atmosphere. The renderer precomputes the light each one
+// scatters towards the camera into a lookup table (AtmosphereTable) once at load time.
+// Optical depths are measured straight up through the shell; a thickness of 0 means none.
+struct Atmosphere {
+    glm::vec3 color;      // Tint and brightness of the scattered light
+    float thickness;      // Height of the shell, in body radii
+    glm::vec3 rayleigh;   // Rayleigh optical depth per channel (gas, scatters blue most)
+    float mie;            // Mie optical depth, the same for every channel (haze and dust)
+
+    static Atmosphere none();
+    static Atmosphere create(const glm::vec3& color, float thickness, const glm::vec3& rayleigh, float mie);
+
+    // Atmosphere of a planet of the default system by lower-case name; none() for the rest
+    static Atmosphere preset(const std::string& name);
+
+    bool isPresent() const { return thickness > 0.0f; }
+
+    // Light scattered towards a viewer per unit of sunlight, looking at the surface at an angle
+    // whose cosine to the normal is mu. rgb is the tinted Rayleigh part, alpha the grey Mie part,
+    // which the shader strengthens towards the sun (forward scattering).
+    glm::vec4 scattering(float mu) const;
+
+    bool operator==(const Atmosphere& other) const = default;
+};
@@ -1,41 +1,36 @@
 #pragma once
-#define GLEW_STATIC 1
-#include <GL/glew.h>
 #include <glm/glm.hpp>
-#include <vector>
 
+// Simulation state of a star, planet or moon. GL resources for drawing it
+// live in BodyRenderer, so this struct has no GL dependency.
 struct CelestialBody {
-    GLuint vao;              // Vertex Array Object for the sphere
-    GLuint texture;          // Body's surface texture
-    unsigned int indexCount; // Number of indices for rendering
     glm::vec3 position;      // Current position in space
     glm::vec3 scale;         // Size of the celestial body
     float rotationAngle;     // Current rotation around its axis
     float rotationSpeed;     // Speed of rotation around its axis
     float orbitRadius;       // Distance from the center of orbit
     float orbitSpeed;        // Speed of orbital movement
+    float orbitPhase;        // Offset added to the orbital angle, in degrees
 
     // Factory method to create a celestial body
-    static CelestialBody create(const char* texturePath,
-                               float scale,
+    static CelestialBody create(float scale,
                                float orbitRadius,
                                float orbitSpeed,
                                float rotationSpeed);
 
     // Update the celestial body's position and rotation
-    void update(const glm::vec3& centerPosition, float baseAngle, float dt);
-    
+    void update(const glm::vec3& centerPosition, double baseAngle, float dt);
+
+    // Position relative to the orbit center for the shared orbital angle (degrees, any magnitude)
+    glm::vec3 orbitOffset(double baseAngle) const;
+
+    // Spin angle at a simulation time, reduced to [0, 360)
+    float rotationAt(double time) const;
+
+    // Scale applied to the sphere mesh: the mesh is turned 180 degrees about X so
+    // textures sit the right way up, which is the same as mirroring Y and Z
+    glm::vec3 meshScale() const { return glm::vec3(scale.x, -scale.y, -scale.z); }
+
     // Get the world transformation matrix for rendering
     glm::mat4 getWorldMatrix() const;
-
-    // Render the celestial body
-    void render(GLuint shader,
-		const glm::mat4 &viewMatrix,
-		const glm::mat4 &projectionMatrix,
-		const glm::vec3 &lightPos,
-		const glm::vec3 &viewPos,
-		bool isSun = false,
-const std::vector<glm::vec3> &allPlanetPositions = std::vector<glm::vec3>(),
-    	const std::vector<float> &allPlanetRadii = std::vector<float>()
-	) const;
 };
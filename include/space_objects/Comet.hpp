@@ -1,6 +1,5 @@
 #pragma once
 #include <vector>
-#include <GL/glew.h>
 #include "CelestialBody.hpp"
 #include "TrailPoint.hpp"
 
@@ -8,29 +7,26 @@ class Comet {
 public:
     CelestialBody body;            // Reuse existing celestial body for the head
     std::vector<TrailPoint> trail; // Trail points
-    float orbitAngle;              // Current angle in elliptical orbit
+    float orbitAngle;              // Current angle in elliptical orbit, in radians
+    float startAngle;              // Orbit angle at simulation time 0
     float eccentricity;            // How elliptical the orbit is (0 = circle, 0.9 = very elliptical)
     float semiMajorAxis;           // Size of the orbit
     glm::vec3 orbitCenter;         // Center point of orbit
-    GLuint trailVAO;               // VAO for trail rendering
-    GLuint trailVBO;               // VBO for trail vertices
     int maxTrailPoints;            // Maximum trail length
-    float lastTrailUpdate;         // Time tracking for trail updates
+    float lastTrailUpdate;         // Clock time of the newest trail point
+    unsigned int trailVersion;     // Incremented whenever the trail changes
 
     // Factory method to create a comet
-    static Comet create(const char* texturePath,
-                       const glm::vec3& orbitCenter,
+    static Comet create(const glm::vec3& orbitCenter,
                        float semiMajorAxis,
                        float eccentricity);
 
-    // Update comet's position and trail
-    void update(float dt, const glm::vec3& sunPosition);
+    // Place the comet on its orbit at a simulation time and extend the trail;
+    // elapsedSeconds is the clock time since the previous update, used to age the trail
+    void update(double simulationTime, const glm::vec3& sunPosition, float currentTime, float elapsedSeconds);
 
-    void updateTrail(float currentTime, const glm::vec3& sunPosition);
-    void updateTrailVBO();
+    // Position and rotation at a simulation time, without touching the trail
+    void evaluate(double simulationTime);
 
-    // Render the comet's trail
-    void renderTrail(GLuint shader, 
-                    const glm::mat4& viewMatrix, 
-                    const glm::mat4& projectionMatrix) const;
+    void updateTrail(float currentTime, float elapsedSeconds, const glm::vec3& sunPosition);
 };
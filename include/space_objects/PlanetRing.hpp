@@ -1,23 +1,23 @@
 #pragma once
-#include <GL/glew.h>
+#include <vector>
 #include <glm/glm.hpp>
 #include "CelestialBody.hpp"
 
+// Ring shape around a planet; RingRenderer owns the GL side
 struct PlanetRing {
-    GLuint vao;
-    GLuint texture;
-    unsigned int indexCount;
-    float innerRadius;
-    float outerRadius;
+    float innerRadius;  // Inner edge, in planet radii
+    float outerRadius;  // Outer edge, in planet radii
+    int segments;       // Number of segments around the ring
+    float tilt;         // Tilt around the X axis in degrees
 
     // Factory method to create Saturn's rings
     static PlanetRing createSaturnRings();
 
-    // Render the planet ring
-    void render(const CelestialBody& planet,
-                GLuint shader,
-                const glm::mat4& viewMatrix,
-                const glm::mat4& projectionMatrix,
-                const glm::vec3& lightPos,
-                const glm::vec3& viewPos) const;
+    // Flat disk with a hole, as positions/UVs/indices for SphereBuffers
+    void generateGeometry(std::vector<glm::vec3>& vertices,
+                          std::vector<glm::vec2>& uvs,
+                          std::vector<unsigned int>& indices) const;
+
+    // Position rings at planet location and scale them with the planet
+    glm::mat4 getWorldMatrix(const CelestialBody& planet) const;
 };
@@ -0,0 +1,19 @@
+#pragma once
+#include <glm/glm.hpp>
+
+// Light given off by an emissive body. Lit surfaces get the full diffuse term near the
+// body, fading smoothly to nothing at range, so the renderer only needs to consider a
+// light where it reaches (ClusteredLights).
+struct StarLight {
+    glm::vec3 color;   // Scales the diffuse term; white for the default sun
+    float range;       // Distance from the body's center at which the light has faded out
+
+    static constexpr float defaultRange = 500.0f;  // Covers every orbit of the default and generated systems
+
+    static StarLight create(const glm::vec3& color, float range);
+
+    // White light reaching the whole system, as a single sun always did
+    static StarLight standard() { return create(glm::vec3(1.0f), defaultRange); }
+
+    bool operator==(const StarLight& other) const = default;
+};
@@ -0,0 +1,12 @@
+#pragma once
+#include <cmath>
+
+class AngleUtils {
+public:
+    // Wrap a periodic value into [0, period). Unlike fmod this costs the same for any
+    // magnitude, which keeps seeking far ahead in simulation time as cheap as a frame.
+    static double wrap(double value, double period) {
+        double turns = value / period;
+        return (turns - std::floor(turns)) * period;
+    }
+};
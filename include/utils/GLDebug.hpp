@@ -0,0 +1,45 @@
+#pragma once
+#include <GL/glew.h>
+
+// GL debug layer on KHR_debug: driver messages arrive through a callback instead of
+// glGetError polling, GL objects carry names, and every GpuProfiler pass is a debug group,
+// so RenderDoc or apitrace captures read like the profiler. It is compiled in with
+// SOLARSCOPE_GL_DEBUG (Debug builds, or -DSOLARSCOPE_GL_DEBUG=ON) and switched on at run time
+// with --gl-debug. Otherwise every function here is an empty inline and no GL call is made,
+// so release builds have no hidden pipeline syncs.
+class GLDebug {
+public:
+#ifdef SOLARSCOPE_GL_DEBUG
+    static constexpr bool compiledIn = true;
+
+    // Install the message callback (synchronous, so a breakpoint in it shows the failing call)
+    // on the current context, which should be a debug context. Without KHR_debug, checkErrors()
+    // falls back to glGetError. False if the layer couldn't be enabled at all.
+    static bool enable();
+    static bool isEnabled() { return enabled; }
+
+    // Name a GL object (GL_TEXTURE, GL_PROGRAM, GL_BUFFER, GL_VERTEX_ARRAY, GL_FRAMEBUFFER, ...)
+    static void label(GLenum identifier, GLuint name, const char* text);
+
+    // Open and close a debug group; pops without a matching push are ignored
+    static void pushGroup(const char* name);
+    static void popGroup();
+
+    // Report pending errors, only when there is no callback to do it; where names the caller
+    static void checkErrors(const char* where);
+
+private:
+    static bool enabled;
+    static bool hasCallback;   // KHR_debug present: messages come through the callback
+    static int groupDepth;
+#else
+    static constexpr bool compiledIn = false;
+
+    static bool enable() { return false; }
+    static bool isEnabled() { return false; }
+    static void label(GLenum, GLuint, const char*) {}
+    static void pushGroup(const char*) {}
+    static void popGroup() {}
+    static void checkErrors(const char*) {}
+#endif
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include <GL/glew.h>
+
+// Wrappers for the GL calls that change pipeline state or draw. All code goes
+// through these instead of calling GL directly, so draw calls and state changes
+// can be counted per frame (perf harness, profiler overlay).
+//
+// The wrappers keep a shadow copy of the state they set and skip calls that would
+// not change it; skipped calls are counted as elided. The shadow state belongs to
+// the one GL context in use. Code that changes this state behind GLState's back, or
+// a switch to another context, must call invalidate().
+class GLState {
+public:
+    struct Counters {
+        unsigned long long drawCalls;      // glDrawArrays/glDrawElements
+        unsigned long long stateChanges;   // Program, VAO, texture and fixed-function state calls issued to GL
+        unsigned long long elidedChanges;  // State calls skipped because the state was already set
+    };
+
+    static Counters counters;   // Accumulates until resetCounters
+
+    static void resetCounters();
+
+    // Forget the shadow state; the next call of each kind reaches GL
+    static void invalidate();
+
+    static void useProgram(GLuint program);
+    static void bindVertexArray(GLuint vao);
+    static void activeTexture(GLenum unit);
+    static void bindTexture(GLenum target, GLuint texture);
+    static void enable(GLenum capability);
+    static void disable(GLenum capability);
+    static void blendFunc(GLenum source, GLenum destination);
+    static void blendFuncSeparate(GLenum sourceRGB, GLenum destinationRGB, GLenum sourceAlpha, GLenum destinationAlpha);
+    static void depthMask(GLboolean write);
+    static void depthFunc(GLenum func);
+    static void polygonMode(GLenum face, GLenum mode);
+    static void lineWidth(GLfloat width);
+
+    static void drawArrays(GLenum mode, GLint first, GLsizei count);
+    static void drawElements(GLenum mode, GLsizei count, GLenum type, const void* indices);
+};
@@ -0,0 +1,79 @@
+#pragma once
+#include <GL/glew.h>
+#include "Profiler.hpp"
+
+// Times render passes on the GPU with GL_TIMESTAMP queries.
+// Each frame gets its own set of query objects; results are read back
+// framesInFlight frames later and only if the driver reports them as
+// available, so profiling never stalls the pipeline. Finished timings are
+// forwarded to Profiler as GPU-track events. Whole-frame times are measured even while
+// profiling is off, for DynamicResolution. Every pass is also a GL debug group (GLDebug).
+class GpuProfiler {
+public:
+    static constexpr int framesInFlight = 4;
+    static constexpr int maxPassesPerFrame = 32;
+
+    bool supported;           // Timer queries available on this context
+    unsigned int droppedFrames; // Frames whose results were not ready in time
+    float lastFrameMs;        // GPU time of the newest frame read back
+    unsigned int timedFrames; // Frames read back so far; changes when lastFrameMs does
+
+    GpuProfiler();
+
+    // Requires a current GL context
+    void initialize();
+
+    void beginFrame();
+    void endFrame();
+
+    void beginPass(const char* name);
+    void endPass();
+
+private:
+    struct Pass {
+        const char* name;
+        int depth;
+        int beginQuery;
+        int endQuery;
+    };
+
+    struct FrameQueries {
+        GLuint queries[maxPassesPerFrame * 2 + 2]; // [0] frame start, [1] frame end
+        Pass passes[maxPassesPerFrame];
+        int passCount;
+        int queryCount;
+        double cpuStartUs;  // Profiler time when the frame started, to align GPU events
+        bool pending;       // Issued but not yet read back
+        bool profiled;      // Passes were timed and go to Profiler
+    };
+
+    void collect(FrameQueries& frame);
+
+    FrameQueries frames[framesInFlight];
+    int openPasses[maxPassesPerFrame];
+    int openPassCount;
+    int skippedDepth;   // Passes begun past maxPassesPerFrame and not yet ended; innermost, so ended first
+    int currentFrame;
+    bool active; // Profiling this frame
+};
+
+// Opens a CPU scope and a GPU pass with the same name for the lifetime of the object
+class ProfilePass {
+public:
+    ProfilePass(GpuProfiler& gpuProfiler, const char* name) : gpu(gpuProfiler) {
+        Profiler::instance().beginScope(name);
+        gpu.beginPass(name);
+    }
+    ~ProfilePass() {
+        gpu.endPass();
+        Profiler::instance().endScope();
+    }
+
+    ProfilePass(const ProfilePass&) = delete;
+    ProfilePass& operator=(const ProfilePass&) = delete;
+
+private:
+    GpuProfiler& gpu;
+};
+
+#define PROFILE_PASS(gpuProfiler, name) ProfilePass PROFILE_CONCAT(profilePass, __LINE__)(gpuProfiler, name)
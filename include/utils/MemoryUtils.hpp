@@ -0,0 +1,13 @@
+#pragma once
+#include <cstddef>
+
+// Process memory figures for the performance harness. Both return 0 where the
+// platform offers no way to read them.
+class MemoryUtils {
+public:
+    // Resident set size right now, in bytes
+    static size_t currentResidentBytes();
+
+    // Largest resident set size since the process started, in bytes
+    static size_t peakResidentBytes();
+};
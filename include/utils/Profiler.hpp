@@ -0,0 +1,115 @@
+#pragma once
+#include <chrono>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Frame profiler for CPU work:
+// - Nested named scopes recorded per frame (use PROFILE_SCOPE)
+// - Rolling history of CPU/GPU frame times for the on-screen graph
+// - Chrome trace JSON export (chrome://tracing or ui.perfetto.dev)
+// GPU timings are fed in by GpuProfiler so this class stays free of GL.
+// Frames belong to the thread that calls beginFrame/endFrame. Another thread can record
+// scopes after setThreadTrack(RENDER); they land in whichever frame is open when they end.
+class Profiler {
+public:
+    enum Track { CPU = 0, GPU = 1, RENDER = 2 };  // RENDER: CPU scopes on the render thread
+
+    struct Event {
+        const char* name;  // Must outlive the profiler (string literal)
+        int track;         // CPU or GPU
+        int depth;         // Nesting level, 0 = top-level scope
+        double startUs;    // Microseconds since the profiler was created
+        double durationUs; // Length of the scope in microseconds
+    };
+
+    struct ScopeStats {
+        const char* name;
+        int track;
+        int depth;
+        float lastMs;      // Time spent in the most recent frame
+        float averageMs;   // Exponential moving average
+        float pendingMs;   // Accumulates while the frame is in progress
+    };
+
+    static constexpr int historySize = 240;          // Frames kept for the graph
+    static constexpr size_t maxCapturedEvents = 1000000; // Trace capture cap
+
+    static Profiler& instance();
+
+    // Track for the calling thread's scopes; threads start on CPU
+    static void setThreadTrack(Track track);
+
+    bool enabled;   // Scope recording; takes effect at the next beginFrame
+
+    void beginFrame();
+    void endFrame();
+
+    void beginScope(const char* name);
+    void endScope();
+
+    // Called by GpuProfiler once query results for an older frame are available
+    void addGpuEvent(const char* name, int depth, double startUs, double durationUs);
+    void addGpuFrameTime(float ms);
+
+    // Trace capture: events recorded between start and stop are written as Chrome trace JSON
+    void startCapture();
+    bool stopCapture(const std::string& path);
+    bool isCapturing() const { return capturing; }
+
+    double nowUs() const;
+    unsigned long long frameIndex() const { return frameCount; }
+
+    // Frame time history, oldest first. Unknown GPU samples are negative.
+    float cpuFrameMs(int age) const;
+    float gpuFrameMs(int age) const;
+    float averageCpuFrameMs() const;
+    float averageGpuFrameMs() const;
+
+    // Lock this while reading the stats or the history from a thread other than the frame's
+    std::mutex& mutex() const { return dataMutex; }
+
+    const std::vector<ScopeStats>& scopeStats() const { return stats; }
+    const std::vector<Event>& lastFrameEvents() const { return previousFrameEvents; }
+
+    void printSummary(std::ostream& out) const;
+
+private:
+    Profiler();
+
+    void recordEvent(const Event& event);
+    void closeScope();
+    ScopeStats& statsFor(const char* name, int track, int depth);
+
+    mutable std::mutex dataMutex;             // Guards everything below against the render thread
+    std::chrono::steady_clock::time_point origin;
+    std::vector<int> openScopes;              // Indices into frameEvents
+    std::vector<Event> frameEvents;           // Events of the frame in progress
+    std::vector<Event> previousFrameEvents;   // Completed frame, for the overlay
+    std::vector<Event> capturedEvents;        // Trace capture buffer
+    std::vector<ScopeStats> stats;
+    float cpuHistory[historySize];
+    float gpuHistory[historySize];
+    int historyHead;                          // Next slot to write
+    int gpuHistoryHead;
+    double frameStartUs;
+    unsigned long long frameCount;
+    bool frameEnabled;                        // Value of enabled latched for this frame
+    bool gpuResultsArrived;                   // GPU stats only advance on frames with results
+    bool capturing;
+};
+
+// RAII helper that opens a profiler scope for the lifetime of the object
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) { Profiler::instance().beginScope(name); }
+    ~ProfileScope() { Profiler::instance().endScope(); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
@@ -0,0 +1,47 @@
+#pragma once
+#include <GL/glew.h>
+#include <string>
+#include <vector>
+
+class ShaderCache;
+
+// Builds a set of programs without waiting on the driver between them. add() submits the
+// compiles and link of each program, or loads its cached binary, and returns the program
+// name straight away; status and logs are only queried in finish(). With
+// GL_KHR_parallel_shader_compile (or the ARB variant) the driver compiles on its own
+// threads, so the caller can load assets meanwhile; without it the driver may still defer
+// work until the first status query.
+class ShaderBatch {
+public:
+    explicit ShaderBatch(ShaderCache& cache);
+    ShaderBatch(const ShaderBatch&) = delete;
+    ShaderBatch& operator=(const ShaderBatch&) = delete;
+
+    // Start building a program from two shader files; usable once finish() returns. defines
+    // ("#define ..." lines) are added to both sources, so permutations of one source are
+    // separate programs with their own cache entries; each needs its own name.
+    GLuint add(const std::string& name,
+               const char* vertexPath,
+               const char* fragmentPath,
+               const std::string& defines = "");
+
+    // Wait for the remaining programs, print compile and link logs, and store new binaries in
+    // the cache. False if any program failed to build; it is still returned by add().
+    bool finish();
+
+    bool isParallel() const { return parallel; }
+
+private:
+    struct Entry {
+        std::string name;
+        GLuint program;
+        GLuint vertexShader;     // 0 when loaded from the cache
+        GLuint fragmentShader;
+        std::string vertexSource;
+        std::string fragmentSource;
+    };
+
+    ShaderCache& cache;
+    std::vector<Entry> entries;
+    bool parallel;
+};
@@ -0,0 +1,41 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstdint>
+#include <string>
+
+// On-disk cache of linked program binaries (glGetProgramBinary), one file per program.
+// Entries are keyed by a hash of the GLSL sources and the driver's vendor, renderer and
+// version strings, so an edited shader or a driver update misses and is rebuilt from
+// source. A binary the driver rejects is treated the same way.
+class ShaderCache {
+public:
+    unsigned int hits;     // Programs loaded from binaries since open
+    unsigned int misses;   // Programs that had to be compiled
+
+    ShaderCache();
+
+    // Requires a current GL context. False, and every lookup misses, when the driver
+    // can't save program binaries.
+    bool open(const std::string& directory);
+    bool isOpen() const { return enabled; }
+
+    // Ask the driver to keep the binary of a program about to be linked, so store() can save it
+    void prepareLink(GLuint program) const;
+
+    // Program created from the cached binary for these sources, 0 on a miss
+    GLuint load(const std::string& name, const std::string& vertexSource, const std::string& fragmentSource);
+
+    // Save a successfully linked program's binary
+    void store(const std::string& name,
+               const std::string& vertexSource,
+               const std::string& fragmentSource,
+               GLuint program) const;
+
+private:
+    uint64_t key(const std::string& vertexSource, const std::string& fragmentSource) const;
+    std::string path(const std::string& name) const;
+
+    bool enabled;
+    std::string directory;
+    std::string driver;    // Vendor, renderer and version, part of every key
+};
@@ -3,36 +3,19 @@
 #include <GL/glew.h>
 #include "../world/ShaderPrograms.hpp"
 
+class ShaderBatch;
+
 class ShaderUtils {
 public:
     static std::string readFile(const char* filePath);
-    
-    // Basic shader sources
-    static std::string getVertexShaderSource();
-    static std::string getFragmentShaderSource();
-    
-    // Selection shader sources
-    static std::string getSelectionVertexShaderSource();
-    static std::string getSelectionFragmentShaderSource();
-    
-    // Skybox shader sources
-    static std::string getSkyboxVertexShaderSource();
-    static std::string getSkyboxFragmentShaderSource();
-    
-    // Textured sphere shader sources
-    static std::string getTexturedSphereVertexShaderSource();
-    static std::string getTexturedSphereFragmentShaderSource();
-    
-    // UI shader sources
-    static std::string getUIVertexShaderSource();
-    static std::string getUIFragmentShaderSource();
-    
-    // Shader compilation methods
-    static int compileVertexAndFragShaders();
-    static unsigned int compileSkyboxShaderProgram();
-    static GLuint compileTexturedSphereShader();
-    static GLuint compileUIShader();
-    
-    // Setup all shader programs
-    static ShaderPrograms setupShaderPrograms();
+
+    // Source with the given "#define ..." lines added after its #version line
+    static std::string withDefines(const std::string& source, const std::string& defines);
+
+    // Start building all shader programs; the names are valid at once, but the programs
+    // may only be used after finishShaderPrograms
+    static ShaderPrograms beginShaderPrograms(ShaderBatch& batch);
+
+    // Wait for the programs started by beginShaderPrograms and set their fixed uniforms
+    static void finishShaderPrograms(ShaderBatch& batch, const ShaderPrograms& shaders);
 };
@@ -0,0 +1,46 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Lock-free triple buffer for one writer thread and one reader thread. The writer fills
+// its back slot and publishes it by swapping it with the middle slot; the reader swaps a
+// freshly published middle slot into its front slot. Neither side ever waits: the writer
+// always has a slot of its own, and the reader always holds the newest complete one
+// (frames the reader was too slow for are skipped).
+//
+// Slots are reused, not cleared, so a writer can update them incrementally. A slot comes
+// back to the writer two publishes after it wrote it.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : middle(1), back(0), front(2) {}
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Writer: the slot to fill next
+    T& writeSlot() { return slots[back]; }
+
+    // Writer: hand the filled slot to the reader
+    void publish() { back = middle.exchange(back | freshBit, std::memory_order_acq_rel) & indexMask; }
+
+    // Reader: switch to the newest published slot; false if nothing new arrived
+    bool update() {
+        if ((middle.load(std::memory_order_relaxed) & freshBit) == 0) {
+            return false;
+        }
+        front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    // Reader: the newest slot taken by update()
+    const T& readSlot() const { return slots[front]; }
+
+private:
+    static constexpr uint8_t indexMask = 3;
+    static constexpr uint8_t freshBit = 4;   // Set on the middle index when it holds an unread slot
+
+    T slots[3];
+    alignas(64) std::atomic<uint8_t> middle;
+    alignas(64) uint8_t back;    // Writer only
+    alignas(64) uint8_t front;   // Reader only
+};
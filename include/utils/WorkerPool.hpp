@@ -0,0 +1,38 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Threads that stay alive between frames for parallel-for style work, so a per-frame job
+// doesn't pay for creating and joining threads. run() calls the job once per worker index and
+// returns when all calls have finished; the calling thread takes index 0 itself.
+class WorkerPool {
+public:
+    explicit WorkerPool(size_t threadCount);   // Threads besides the caller
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Workers run() can use, the calling thread included
+    size_t size() const { return threads.size() + 1; }
+
+    // job(worker) for each worker in [0, count); count is capped at size()
+    void run(size_t count, const std::function<void(size_t)>& job);
+
+private:
+    void workerLoop(size_t worker);
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;      // A job was posted, or the pool is stopping
+    std::condition_variable finished;  // The last worker of a job is done
+    const std::function<void(size_t)>* job = nullptr;
+    size_t jobCount = 0;
+    size_t remaining = 0;              // Pool threads still running the current job
+    uint64_t generation = 0;           // Bumped per job, so each thread runs it once
+    bool stopping = false;
+};
@@ -1,11 +1,9 @@
 #pragma once
-#define GLEW_STATIC 1
-#include <GL/glew.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
-#include <GLFW/glfw3.h>
+#include "include/input/FrameInput.hpp"
 
-class CelestialBody;  // Forward declaration
+struct CelestialBody;  // Forward declaration
 
 class Camera {
 public:
@@ -31,13 +29,13 @@ public:
     {}
 
     // Update camera position for selected planet view
-    void updateForSelectedPlanet(class CelestialBody* selectedBody, float dt);
+    void updateForSelectedPlanet(CelestialBody* selectedBody, float dt);
     
     // Update camera angles based on mouse movement
     void updateAngles(float dx, float dy, float dt);
     
     // Update camera position based on keyboard input
-    void updatePosition(class GLFWwindow* window, float dt);
+    void updatePosition(const FrameInput& input, float dt);
     
     // Get view matrix based on camera state
     glm::mat4 updateViewMatrix() const;
@@ -1,16 +1,15 @@
 #pragma once
 #include <GL/glew.h>
-#include <GLFW/glfw3.h>
 #include <string>
 #include <vector>
 #include <algorithm>
 #include <iostream>
 #include "PlanetInfo.hpp"
+#include "include/input/FrameInput.hpp"
 
 class InfoPanel {
 public:
     bool visible;
-    bool wasIPressed;
     PlanetInfo currentInfo;
     float fadeAlpha;
     GLuint currentTexture;         // Current planet info texture
@@ -23,7 +22,8 @@ public:
     void hide();
     void toggle(const PlanetInfo& info);
     void update(float dt);
-    void handleInput(GLFWwindow* window, const PlanetInfo& currentPlanetInfo);
+    bool isFading() const { return visible ? fadeAlpha < 1.0f : fadeAlpha > 0.0f; }
+    void handleInput(const FrameInput& input, const PlanetInfo& currentPlanetInfo);
     
     // Renders the semi-transparent background for the info panel
     void renderBackground(GLuint shader, int windowWidth, int windowHeight) const;
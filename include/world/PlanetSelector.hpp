@@ -2,7 +2,6 @@
 #include <vector>
 #include <string>
 #include <iostream>
-#include <GL/glew.h>
 #include <glm/glm.hpp>
 #include "include/space_objects/CelestialBody.hpp"
 #include "include/world/PlanetInfo.hpp"
@@ -13,7 +12,6 @@ public:
     std::vector<std::string> celestialNames;
     std::vector<PlanetInfo> planetInfos;
     int selectedIndex;
-    bool was3Pressed;
 
     PlanetSelector();
     void addCelestialBody(CelestialBody* body, const std::string& name, const PlanetInfo& info);
@@ -21,11 +19,6 @@ public:
     CelestialBody* getSelectedBody();
     std::string getSelectedName();
     PlanetInfo getSelectedInfo();
-    
-    // Render selection indicator for the currently selected planet
-    void renderSelectionIndicator(GLuint shader,
-                                const glm::mat4& viewMatrix,
-                                const glm::mat4& projectionMatrix) const;
                                 
     // Setup planet selector with detailed information
     static PlanetSelector setupWithInfo(std::vector<CelestialBody*>& allBodies);
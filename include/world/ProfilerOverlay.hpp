@@ -0,0 +1,30 @@
+#pragma once
+#include <GL/glew.h>
+#include <vector>
+
+// On-screen profiler HUD drawn in the bottom-left corner:
+// - Frame time graph for CPU (green) and GPU (orange) over the last frames
+// - Reference lines at 16.7 ms (60 fps) and 33.3 ms (30 fps)
+// - Stacked bars splitting the last frame into top-level CPU scopes and GPU passes
+// Scope colors are listed on the console when the overlay is switched on.
+class ProfilerOverlay {
+public:
+    bool visible;
+    GLuint vao;
+    GLuint vbo;
+
+    ProfilerOverlay();
+
+    // Requires a current GL context
+    void initialize();
+    void toggle();
+
+    void render(GLuint hudShader, int windowWidth, int windowHeight);
+
+private:
+    std::vector<float> vertices; // x, y, r, g, b, a per vertex; reused every frame
+
+    void addQuad(float x, float y, float width, float height, const float* color);
+    void addLine(float x0, float y0, float x1, float y1, const float* color);
+    void printLegend() const;
+};
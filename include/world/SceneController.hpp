@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include "include/input/FrameInput.hpp"
+#include "include/simulation/SimulationClock.hpp"
+#include "include/simulation/SolarSystem.hpp"
+#include "include/simulation/StateHistory.hpp"
+#include "include/world/Camera.hpp"
+#include "include/world/PlanetSelector.hpp"
+
+// Applies one frame of input to the scene: time controls, comparison mode, the black
+// hole, planet selection and the camera. Holds no GL or window state, so recorded
+// input can drive it headless (tools/headless_replay.cpp).
+class SceneController {
+public:
+    SolarSystem solarSystem;
+    Camera camera;
+    PlanetSelector planetSelector;   // Points into solarSystem.bodies
+    bool planetSelectionMode;
+    bool isPaused;
+    float timeSpeed;                 // Normal speed = 1.0, faster = >1.0, slower = <1.0, reverse = negative
+    StateHistory history;            // Recorded frames for reverse playback and scrubbing
+    SimulationClock clock;           // Fixed simulation steps, independent of the frame rate
+    glm::mat4 projectionMatrix;      // The app's projection; the simulation LOD projects bodies with it
+    float viewportHeight;            // Pixels, for the LOD's screen coverage
+    uint64_t frameCount;             // Frames simulated so far (updateSimulation calls)
+
+    static constexpr float scrubSecondsPerSecond = 5.0f;  // Simulated seconds per second of [ or ], times speed
+
+    // Planet selection covers the default system's named bodies; other systems get an empty selector
+    explicit SceneController(SolarSystem system = SolarSystem::createDefault());
+    SceneController(const SceneController&) = delete;
+    SceneController& operator=(const SceneController&) = delete;
+
+    // Keyboard toggles: pause, time speed, comparison mode, black hole and planet selection
+    void handleInput(const FrameInput& input);
+
+    // Run the fixed simulation steps due this frame and pose bodies between the last two,
+    // or play back recorded frames when reversing or scrubbing
+    void updateSimulation(const FrameInput& input);
+
+    // Follow the selected planet, or fly with mouse, WASD/QE and arrow keys
+    void updateCamera(const FrameInput& input);
+
+    // handleInput, updateSimulation and updateCamera in frame order
+    void update(const FrameInput& input);
+
+    float animationDt(const FrameInput& input) const { return isPaused ? 0.0f : input.dt * timeSpeed; }
+
+    // True while the scene moves on its own: time running, or the black hole still collapsing
+    // (it runs on clock time, so pausing doesn't stop it). Comet trails hold still while paused.
+    bool isAnimating() const {
+        return !isPaused || (solarSystem.blackHole.active && solarSystem.blackHole.strength < 1.0f);
+    }
+
+    // Clock time of the last step, for everything timed in wall-clock seconds
+    float clockTime() const { return static_cast<float>(clock.time()); }
+
+    // FNV-1a hash of body, comet and camera state, for comparing replays across runs and builds
+    uint64_t stateChecksum() const;
+
+    bool isReviewingHistory() const { return reviewingHistory; }
+
+private:
+    // Restore a recorded frame instead of simulating; false when the frame should be simulated
+    bool updateFromHistory(const FrameInput& input, float dt);
+    // Continue live from the reviewed frame, dropping the frames after it
+    void leaveHistory();
+
+    float lastStepDt;      // Animation time of the last fixed step, for interpolation
+    double historyCursor;  // Simulation time being reviewed
+    bool reviewingHistory; // Showing a recorded frame rather than the newest state
+    double lastCursorX;
+    double lastCursorY;
+    bool hasCursor;    // False until the first frame provides a cursor position
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "include/space_objects/CelestialBody.hpp"
+#include "include/space_objects/StarLight.hpp"
+#include "include/space_objects/TrailPoint.hpp"
+
+class SceneController;
+
+// Everything drawn in one frame, copied out of the simulation so a render thread can draw
+// it while the next frame is simulated (handed over through a TripleBuffer). Holds no GL
+// state. Slots are reused: capture() overwrites in place and copies a comet trail only when
+// it changed since this slot last held it.
+struct SceneSnapshot {
+    struct CometView {
+        glm::mat4 headMatrix;
+        std::vector<TrailPoint> trail;
+        unsigned int trailVersion = 0;   // Comet::trailVersion of the copied trail
+        bool hasTrail = false;
+    };
+
+    uint64_t frame = 0;                  // SceneController::frameCount when captured; 0 = never captured
+    double clockTime = 0.0;              // Clock time it shows, between the last two steps; drives UI animation
+
+    // Scene, indexed like SolarSystem::bodies, rings and comets
+    std::vector<glm::mat4> bodyMatrices;
+    std::vector<int> visibleBodies;      // Bodies to draw, parent-first
+    std::vector<glm::mat4> ringMatrices;
+    std::vector<CometView> comets;
+    std::vector<glm::vec3> shadowPositions;   // SolarSystem::collectShadowCasters
+    std::vector<float> shadowRadii;
+    std::vector<glm::vec3> lightPositions;    // SolarSystem::collectLights
+    std::vector<StarLight> lights;
+
+    // Camera and selection
+    glm::mat4 viewMatrix = glm::mat4(1.0f);
+    glm::vec3 cameraPosition = glm::vec3(0.0f);
+    bool firstPerson = true;
+    bool planetSelectionMode = false;
+    bool hasSelection = false;
+    CelestialBody selectedBody{};
+
+    // App UI, filled in by the app after capture
+    bool infoPanelVisible = false;
+    float infoPanelAlpha = 0.0f;
+    unsigned int infoPanelTexture = 0;   // GL texture name chosen by InfoPanel::show
+    bool profilerOverlayVisible = false;
+
+    // Copy the scene controller's current state
+    void capture(SceneController& scene);
+};
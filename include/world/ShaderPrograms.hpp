@@ -1,9 +1,26 @@
 #pragma once
+#include <cstddef>
+
+// Permutations of textured_sphere.frag.glsl, compiled from the one source with different #defines
+enum class SphereVariant {
+    Sun = 0,          // SUN: self-lit with a rim glow
+    Planet,           // ATMOSPHERE: lit, with atmospheric scattering (comparison mode)
+    PlanetShadowed,   // ATMOSPHERE SHADOWS: lit, tested against the shadow casters
+    Airless,          // Lit only: airless bodies in comparison mode
+    AirlessShadowed,  // SHADOWS: moons, airless planets, comet heads
+    Ring,             // OIT: lit only, into the transparency targets
+    Count
+};
 
 struct ShaderPrograms {
     int base;
     unsigned int skybox;
-    unsigned int orb;
+    unsigned int sphere[static_cast<size_t>(SphereVariant::Count)];  // Indexed by SphereVariant
     unsigned int ui;
     unsigned int selection;  // For selection indicator
+    unsigned int hud;        // For the profiler overlay
+    unsigned int trail;      // Comet trails, into the transparency targets
+    unsigned int oitComposite;  // Blends the transparency targets over the scene
+
+    unsigned int sphereProgram(SphereVariant variant) const { return sphere[static_cast<size_t>(variant)]; }
 };
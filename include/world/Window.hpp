@@ -5,6 +5,7 @@
 
 class Window {
 public:
-    static GLFWwindow* initializeGLFW();
+    // debugContext asks for a GL debug context, for GLDebug
+    static GLFWwindow* initializeGLFW(bool debugContext = false);
     static bool initializeOpenGL();
 };
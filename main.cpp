@@ -3,36 +3,66 @@
 #include <glm/common.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <atomic>
+#include <chrono>
+#include <ctime>
 #include <iostream>
 #include <list>
+#include <memory>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
 #define GLEW_STATIC 1
-#define STB_IMAGE_IMPLEMENTATION
-#include "include/stb_image.h"
 
 #include "include/models/Mesh.hpp"
 #include "include/models/Model.hpp"
 
-#include "include/space_objects/BlackHole.hpp"
-#include "include/space_objects/CelestialBody.hpp"
-#include "include/space_objects/Comet.hpp"
-#include "include/space_objects/PlanetRing.hpp"
-#include "include/space_objects/TrailPoint.hpp"
+#include "include/rendering/ClusteredLights.hpp"
+#include "include/rendering/DynamicResolution.hpp"
+#include "include/rendering/QualityGovernor.hpp"
+#include "include/rendering/QualitySettings.hpp"
+#include "include/rendering/RenderQueue.hpp"
+#include "include/rendering/SceneRenderer.hpp"
+#include "include/rendering/SelectionRenderer.hpp"
+#include "include/rendering/TransparencyPass.hpp"
 
+#include "include/input/FrameInput.hpp"
+#include "include/input/GlfwInput.hpp"
+#include "include/input/InputRecorder.hpp"
+#include "include/input/InputReplayer.hpp"
+
+#include "include/perf/PerfReport.hpp"
+#include "include/perf/PerfScenario.hpp"
+
+#include "include/simulation/Ephemeris.hpp"
+#include "include/simulation/SceneFile.hpp"
+#include "include/simulation/SolarSystem.hpp"
+
+#include "include/utils/AngleUtils.hpp"
 #include "include/utils/GeometryUtils.hpp"
+#include "include/utils/GLDebug.hpp"
+#include "include/utils/GLState.hpp"
+#include "include/utils/GpuProfiler.hpp"
+#include "include/utils/MemoryUtils.hpp"
+#include "include/utils/Profiler.hpp"
+#include "include/utils/ShaderBatch.hpp"
+#include "include/utils/ShaderCache.hpp"
 #include "include/utils/ShaderUtils.hpp"
-#include "include/utils/SphereUtils.hpp"
 #include "include/utils/TextureUtils.hpp"
+#include "include/utils/TripleBuffer.hpp"
 
 #include "include/world/Camera.hpp"
 #include "include/world/InfoPanel.hpp"
 #include "include/world/PlanetInfo.hpp"
 #include "include/world/PlanetSelector.hpp"
+#include "include/world/ProfilerOverlay.hpp"
+#include "include/world/SceneController.hpp"
+#include "include/world/SceneSnapshot.hpp"
 #include "include/world/ShaderPrograms.hpp"
 #include "include/world/Skybox.hpp"
 #include "include/world/Window.hpp"
@@ -42,8 +72,176 @@ using namespace std;
 
 int main(int argc, char *argv[])
 {
+    // Command line:
+    //   --trace <file>     capture a Chrome trace from startup until exit
+    //   --record <file>    record input and frame times for later replay
+    //   --replay <file>    drive the app from a recording and exit when it ends
+    //   --fixed-dt <secs>  replay with a fixed frame time instead of the recorded one
+    //   --scene <file>     load a scene file (see SceneFile.hpp) instead of the built-in solar system
+    //   --ephemeris <file> place bodies at their real positions from a table (tools/ephemeris_gen.cpp)
+    //   --date YYYY-MM-DD  ephemeris date at startup, today by default
+    //   --perf <scene>     run a scripted perf scenario and exit (see tools/perf_gate.cpp)
+    //   --perf-out <file>  where the perf scenario writes its report
+    //   --single-thread    simulate and render on one thread (perf scenarios always do)
+    //   --frame-budget <ms> frame time the scene resolution and quality adapt to hold, 0 for full quality
+    //   --quality <knob> <best> <worst>  bounds for a quality knob (see the QualityGovernor setup below)
+    //   --no-idle          keep redrawing at full rate while paused and still
+    //   --gl-debug         driver messages, object labels and pass groups (builds with SOLARSCOPE_GL_DEBUG)
+    std::string tracePath = "solarscope_trace.json";
+    bool traceFromStartup = false;
+    std::string recordPath;
+    std::string replayPath;
+    float fixedDt = 0.0f;
+    std::string scenePath;
+    std::string ephemerisPath;
+    std::string dateText;
+    std::string perfScene;
+    std::string perfOutPath = "perf_report.txt";
+    bool singleThread = false;
+    float frameBudgetMs = 16.0f;
+    struct KnobBounds
+    {
+        std::string name;
+        float best;
+        float worst;
+    };
+    std::vector<KnobBounds> knobBounds;
+    bool idleMode = true;
+    bool glDebug = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--trace" && i + 1 < argc)
+        {
+            tracePath = argv[++i];
+            traceFromStartup = true;
+        }
+        else if (arg == "--record" && i + 1 < argc)
+        {
+            recordPath = argv[++i];
+        }
+        else if (arg == "--replay" && i + 1 < argc)
+        {
+            replayPath = argv[++i];
+        }
+        else if (arg == "--fixed-dt" && i + 1 < argc)
+        {
+            fixedDt = std::stof(argv[++i]);
+        }
+        else if (arg == "--scene" && i + 1 < argc)
+        {
+            scenePath = argv[++i];
+        }
+        else if (arg == "--ephemeris" && i + 1 < argc)
+        {
+            ephemerisPath = argv[++i];
+        }
+        else if (arg == "--date" && i + 1 < argc)
+        {
+            dateText = argv[++i];
+        }
+        else if (arg == "--perf" && i + 1 < argc)
+        {
+            perfScene = argv[++i];
+        }
+        else if (arg == "--perf-out" && i + 1 < argc)
+        {
+            perfOutPath = argv[++i];
+        }
+        else if (arg == "--single-thread")
+        {
+            singleThread = true;
+        }
+        else if (arg == "--frame-budget" && i + 1 < argc)
+        {
+            frameBudgetMs = std::stof(argv[++i]);
+        }
+        else if (arg == "--quality" && i + 3 < argc)
+        {
+            KnobBounds bounds;
+            bounds.name = argv[++i];
+            bounds.best = std::stof(argv[++i]);
+            bounds.worst = std::stof(argv[++i]);
+            knobBounds.push_back(bounds);
+        }
+        else if (arg == "--no-idle")
+        {
+            idleMode = false;
+        }
+        else if (arg == "--gl-debug")
+        {
+            glDebug = true;
+        }
+    }
+
+    // Perf scenarios script their own input and camera, at a fixed frame time
+    PerfScenario perfScenario;
+    bool perfMode = !perfScene.empty();
+    if (perfMode && !PerfScenario::find(perfScene, perfScenario))
+    {
+        std::cerr << "Unknown perf scenario: " << perfScene << std::endl;
+        return -1;
+    }
+    PerfReport perfReport;
+    int perfFrame = 0;
+
+    // The simulated scene: a perf scenario's, a scene file or the built-in solar system
+    SolarSystem initialSystem = SolarSystem::createDefault();
+    if (perfMode)
+    {
+        initialSystem = perfScenario.buildSystem();
+    }
+    else if (!scenePath.empty() && !SceneFile::load(scenePath, initialSystem))
+    {
+        return -1;
+    }
+
+    // Ephemeris mode: real positions for a date, the table mapped and read page by page as dates need it
+    if (!ephemerisPath.empty() && !perfMode)
+    {
+        // Julian date of 0h UT today; the Unix epoch is JD 2440587.5
+        double julianDate = 2440587.5 + static_cast<double>(std::time(nullptr) / 86400);
+        if (!dateText.empty() && !Ephemeris::parseDate(dateText, julianDate))
+        {
+            std::cerr << "Invalid --date, expected YYYY-MM-DD: " << dateText << std::endl;
+            return -1;
+        }
+        auto ephemeris = std::make_shared<Ephemeris>();
+        if (!ephemeris->open(ephemerisPath))
+        {
+            return -1;
+        }
+        if (!initialSystem.attachEphemeris(ephemeris, julianDate))
+        {
+            std::cerr << "No bodies in the scene match the ephemeris: " << ephemerisPath << std::endl;
+            return -1;
+        }
+        std::cout << "Ephemeris: " << Ephemeris::formatDate(julianDate) << " (table covers "
+                  << Ephemeris::formatDate(ephemeris->startJd()) << " to " << Ephemeris::formatDate(ephemeris->endJd())
+                  << ")" << std::endl;
+    }
+
+    // Input comes from the window, or from a recording when replaying
+    InputReplayer replayer;
+    replayer.fixedDt = fixedDt;
+    if (!replayPath.empty() && !replayer.open(replayPath))
+    {
+        return -1;
+    }
+    InputRecorder recorder;
+    if (!recordPath.empty() && !recorder.open(recordPath))
+    {
+        return -1;
+    }
+
     // Initialize GLFW and OpenGL
-    GLFWwindow *window = Window::initializeGLFW();
+    if (glDebug && !GLDebug::compiledIn)
+    {
+        std::cout << "--gl-debug: the GL debug layer is not in this build (Debug or -DSOLARSCOPE_GL_DEBUG=ON)"
+                  << std::endl;
+        glDebug = false;
+    }
+    GLFWwindow *window = Window::initializeGLFW(glDebug);
     if (!window)
     {
         return -1;
@@ -54,173 +252,97 @@ int main(int argc, char *argv[])
         glfwTerminate();
         return -1;
     }
+    if (glDebug)
+    {
+        GLDebug::enable();
+    }
 
-    // Enable OpenGL features
-    glEnable(GL_CULL_FACE);
-    glEnable(GL_DEPTH_TEST);
+    // Measure frames as fast as they render, not at the display's refresh rate
+    if (perfMode)
+    {
+        glfwSwapInterval(0);
+    }
 
-    // Setup shaders and camera
-    ShaderPrograms shaders = ShaderUtils::setupShaderPrograms();
-    Camera camera; // Constructor handles setup
+    // Enable OpenGL features
+    GLState::enable(GL_CULL_FACE);
+    GLState::enable(GL_DEPTH_TEST);
+
+    // Start compiling shaders; the driver works on them while models and textures load below
+    ShaderCache shaderCache;
+    shaderCache.open("shader_cache");
+    ShaderBatch shaderBatch(shaderCache);
+    ShaderPrograms shaders = ShaderUtils::beginShaderPrograms(shaderBatch);
+
+    // Setup the scene (simulation, camera and planet selection)
+    SceneController scene(std::move(initialSystem));
+    SolarSystem &solarSystem = scene.solarSystem;
+    Camera &camera = scene.camera;
+    PlanetSelector &planetSelector = scene.planetSelector;
+
+    // Setup profiling (F1: overlay, F2: start/stop trace capture)
+    Profiler &profiler = Profiler::instance();
+    GpuProfiler gpuProfiler;
+    gpuProfiler.initialize();
+    ProfilerOverlay profilerOverlay;
+    profilerOverlay.initialize();
 
     // Setup projection and view matrices
-    mat4 projectionMatrix = glm::perspective(70.0f, 800.0f / 600.0f, 0.01f, 100.0f);
-
-    mat4 viewMatrix = camera.updateViewMatrix();
-
-    GLuint projectionMatrixLocation = glGetUniformLocation(shaders.base, "projectionMatrix");
+    const float nearPlane = 0.01f;
+    const float farPlane = 100.0f;
+    mat4 projectionMatrix = glm::perspective(70.0f, 800.0f / 600.0f, nearPlane, farPlane);
+    scene.projectionMatrix = projectionMatrix;
 
-    GLuint viewMatrixLocation = glGetUniformLocation(shaders.base, "viewMatrix");
-
-    glUniformMatrix4fv(projectionMatrixLocation, 1, GL_FALSE, &projectionMatrix[0][0]);
-    glUniformMatrix4fv(viewMatrixLocation, 1, GL_FALSE, &viewMatrix[0][0]);
+    // Replays and perf runs report checksums; a time budget would make them depend on machine speed
+    if (replayer.isOpen() || perfMode)
+    {
+        solarSystem.scheduler.budgetMicroseconds = 0.0;
+    }
 
     // Create scene objects
     int vao = GeometryUtils::createVertexBufferObject();
     Model duckModel = Model::loadFromFile("models/rubber_duck/scene.gltf");
 
-    // Setup celestial bodies with realistic proportions
-    // Using a scale where Earth = 0.3f as base reference
-
-    /// SUN - Center of the system
-    CelestialBody sun = CelestialBody::create("textures/planet/sun.jpg",
-                                      4.0f,   // Scale
-                                      0.0f,   // Orbit radius
-                                      0.0f,   // Orbit speed
-                                      15.0f);  // Rotation speed
-    sun.position = vec3(0.0f, 0.0f, -20.0f);
-
-    // MERCURY - Smallest planet, closest orbit
-    CelestialBody mercury = CelestialBody::create("textures/planet/mercury.jpg",
-                                                0.11f, // Small size
-                                                8.0f,  // Safe distance from sun (was 3.0f)
-                                                2.0f,  // Fastest orbital speed
-                                                35.0f  // Fast rotation
-    );
-
-    // VENUS - Second planet
-    CelestialBody venus = CelestialBody::create("textures/planet/venus.jpg",
-                                              0.28f, // Venus size
-                                              10.0f, // Safe distance from mercury (was 4.5f)
-                                              1.6f,  // Orbital speed
-                                              -12.0f // Slow retrograde rotation
-    );
-
-    // EARTH - Third planet
-    CelestialBody earth = CelestialBody::create("textures/planet/earth.jpg",
-                                              0.35f, // Earth size
-                                              12.0f, // Safe distance from venus (was 6.0f)
-                                              1.0f,  // Earth orbital speed reference
-                                              20.0f  // Earth rotation speed
-    );
-
-    // MOON - Orbits Earth
-    CelestialBody moon = CelestialBody::create("textures/planet/moon.jpg",
-                                             0.08f, // Small moon size
-                                             1.2f,  // Distance from Earth (increased from 1.0f)
-                                             4.0f,  // Fast orbit around Earth
-                                             5.0f   // Moon rotation
-    );
-
-    // MARS - Fourth planet
-    CelestialBody mars = CelestialBody::create("textures/planet/mars.jpg",
-                                             0.16f, // Mars size
-                                             15.0f, // Safe distance from Earth (was 7.5f)
-                                             0.8f,  // Slower orbital speed than Earth
-                                             18.0f  // Rotation speed
-    );
-
-    // JUPITER - Fifth planet, largest
-    CelestialBody jupiter = CelestialBody::create("textures/planet/jupiter.jpg",
-                                                3.36f, // Large size
-                                                20.0f, // Safe distance from Mars (was 10.0f)
-                                                0.5f,  // Slower orbital speed
-                                                30.0f  // Fast rotation speed
-    );
-
-    // SATURN - Sixth planet with rings
-    CelestialBody saturn = CelestialBody::create("textures/planet/saturn.jpg",
-                                               2.82f, // Large size
-                                               36.0f, // Increased distance from Jupiter to accommodate rings
-                                               0.35f, // Slow orbital speed
-                                               28.0f  // Fast rotation speed
-    );
-
-    // URANUS - Seventh planet
-    CelestialBody uranus = CelestialBody::create("textures/planet/uranus.jpg",
-                                               1.4f,  // Medium size
-                                               50.0f, // Increased distance from Saturn to avoid ring collision
-                                               0.25f, // Very slow orbital speed
-                                               -15.0f // Retrograde rotation
-    );
-
-    // NEPTUNE - Outermost planet
-    CelestialBody neptune = CelestialBody::create("textures/planet/neptune.jpg",
-                                                1.17f, // Medium size
-                                                55.0f, // Safe distance from Uranus (was 22.0f)
-                                                0.2f,  // Slowest orbital speed
-                                                18.0f  // Normal rotation speed
-    );
-
-    Comet halleysComet = Comet::create("textures/comet/comet.jpg", vec3(0.0f, 0.0f, -20.0f), 45.0f, 0.85f);
-
-    Comet comet2 = Comet::create("textures/comet/comet.jpg", vec3(0.0f, 0.0f, -20.0f), 25.0f, 0.7f);
-    comet2.orbitAngle = 180.0f; // Start on opposite side
-
-    // Create Saturn's rings
-    PlanetRing saturnRings = PlanetRing::createSaturnRings();
-
-    // Setup planet selector with detailed information
-    vector<CelestialBody *> allBodies =
-        {&sun, &mercury, &mars, &venus, &earth, &moon, &neptune, &uranus, &saturn, &jupiter};
-    PlanetSelector planetSelector = PlanetSelector::setupWithInfo(allBodies);
+    // GL resources that draw the simulated scene; sphere detail follows size in window pixels
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    SceneRenderer sceneRenderer = SceneRenderer::create(solarSystem, 0.5f * viewport[3] * projectionMatrix[1][1]);
+    RenderQueue renderQueue;
+
+    // Offscreen scene and weighted blended transparency targets, at the window's framebuffer size
+    TransparencyPass transparency = TransparencyPass::create(viewport[2], viewport[3], shaders.oitComposite);
+    ClusteredLights clusteredLights = ClusteredLights::create(viewport[2], viewport[3], nearPlane, farPlane);
+
+    // Scene resolution follows the GPU frame time; perf scenarios measure a fixed amount of work
+    DynamicResolution dynamicResolution =
+        DynamicResolution::create(viewport[2], viewport[3], perfMode ? 0.0f : frameBudgetMs);
+    unsigned int timedFrames = 0;
+
+    // Quality knobs, lowered in this order when frames go over the budget and raised in reverse.
+    // Comet trail points are the only particles, so the trail length is also the particle budget.
+    QualitySettings quality;
+    QualityGovernor qualityGovernor(perfMode ? 0.0f : frameBudgetMs);
+    qualityGovernor.addKnob("trail-length", quality.trailFraction, 1.0f, 0.25f, 0.25f);
+    qualityGovernor.addKnob("shadow-casters", quality.shadowCasters,
+                            static_cast<float>(SolarSystem::maxShadowCasters), 0.0f, 3.0f);
+    qualityGovernor.addKnob("sphere-lod-bias", quality.sphereLodBias, 0.0f, 2.0f, 0.5f);
+    qualityGovernor.addKnob("render-scale", quality.renderScaleLimit, DynamicResolution::maxScale,
+                            DynamicResolution::minScale, 0.125f);
+    for (const KnobBounds &bounds : knobBounds)
+    {
+        if (!qualityGovernor.setBounds(bounds.name, bounds.best, bounds.worst))
+        {
+            std::cerr << "Unknown quality knob: " << bounds.name << std::endl;
+            return -1;
+        }
+    }
+    dynamicResolution.setScaleLimit(quality.renderScaleLimit);
+    float lastRenderMs = 0.0f;
+    SelectionRenderer selectionRenderer = SelectionRenderer::create();
 
     // Add info panel
     InfoPanel infoPanel;
     infoPanel.loadPlanetTextures();
 
-
-    // Add planet selection mode flag
-    bool planetSelectionMode = false;
-
-    // Store reset positions AFTER bodies are created but BEFORE any updates
-    BlackHole blackHole = BlackHole::create();
-
-    // Now set up initial orbital positions for normal animation
-    mercury.update(sun.position, 0.0f, 0.0f);
-    venus.update(sun.position, 45.0f, 0.0f);
-    earth.update(sun.position, 90.0f, 0.0f);
-    mars.update(sun.position, 135.0f, 0.0f);
-    jupiter.update(sun.position, 180.0f, 0.0f);
-    saturn.update(sun.position, 225.0f, 0.0f);
-    uranus.update(sun.position, 270.0f, 0.0f);
-    neptune.update(sun.position, 315.0f, 0.0f);
-    moon.update(earth.position, 0.0f, 0.0f);
-
-    // Store these as the RESET positions (what we return to with R key)
-    blackHole.resetPositions.clear();
-    blackHole.resetScales.clear();
-    blackHole.resetPositions.push_back(sun.position);
-    blackHole.resetScales.push_back(sun.scale);
-    blackHole.resetPositions.push_back(mercury.position);
-    blackHole.resetScales.push_back(mercury.scale);
-    blackHole.resetPositions.push_back(venus.position);
-    blackHole.resetScales.push_back(venus.scale);
-    blackHole.resetPositions.push_back(earth.position);
-    blackHole.resetScales.push_back(earth.scale);
-    blackHole.resetPositions.push_back(moon.position);
-    blackHole.resetScales.push_back(moon.scale);
-    blackHole.resetPositions.push_back(mars.position);
-    blackHole.resetScales.push_back(mars.scale);
-    blackHole.resetPositions.push_back(jupiter.position);
-    blackHole.resetScales.push_back(jupiter.scale);
-    blackHole.resetPositions.push_back(saturn.position);
-    blackHole.resetScales.push_back(saturn.scale);
-    blackHole.resetPositions.push_back(uranus.position);
-    blackHole.resetScales.push_back(uranus.scale);
-    blackHole.resetPositions.push_back(neptune.position);
-    blackHole.resetScales.push_back(neptune.scale);
-
     // Setup skybox
     std::vector<std::string> skyboxFaces = {"textures/skybox/1.png",
                                             "textures/skybox/2.png",
@@ -230,306 +352,83 @@ int main(int argc, char *argv[])
                                             "textures/skybox/6.png"};
     Skybox skybox = Skybox::create(skyboxFaces);
 
-    // Initialize animation variables
-    float spinningCubeAngle = 0.0f;
-    float orbAngle = 0.0f;
-    float orbRadius = 2.0f;
-    float orbHeight = 1.0f;
-    float orbSize = 0.2f;
+    // Shaders are needed from here on
+    ShaderUtils::finishShaderPrograms(shaderBatch, shaders);
 
-    // Set up texture uniform for the base shader
-    glUseProgram(shaders.base);
-    glUniform1i(glGetUniformLocation(shaders.base, "texture1"), 0);
+    mat4 viewMatrix = camera.updateViewMatrix();
 
-    // Initialize timing and input state
-    float lastFrameTime = glfwGetTime();
-    double lastMousePosX, lastMousePosY;
-    glfwGetCursorPos(window, &lastMousePosX, &lastMousePosY);
-    bool isPaused = false;
-    bool wasSpacePressed = false;
-    bool comparisonMode = false;
-    bool wasCPressed = false;
+    GLuint projectionMatrixLocation = glGetUniformLocation(shaders.base, "projectionMatrix");
 
-    // Time control variables
-    float timeSpeed = 1.0f; // Normal speed = 1.0, faster = >1.0, slower = <1.0, reverse = negative
-    bool wasEqualPressed = false;
-    bool wasMinusPressed = false;
-    bool wasTPressed = false;
+    GLuint viewMatrixLocation = glGetUniformLocation(shaders.base, "viewMatrix");
 
-    // Input state tracking for X & R keys
-    static bool wasXPressed = false;
-    static bool wasRPressed = false;
+    glUniformMatrix4fv(projectionMatrixLocation, 1, GL_FALSE, &projectionMatrix[0][0]);
+    glUniformMatrix4fv(viewMatrixLocation, 1, GL_FALSE, &viewMatrix[0][0]);
 
+    // Set up texture uniform for the base shader
+    GLState::useProgram(shaders.base);
+    glUniform1i(glGetUniformLocation(shaders.base, "texture1"), 0);
 
-    // Main loop
-    while (!glfwWindowShouldClose(window))
+    // Draw one frame from a snapshot. With a render thread this is all that touches GL after
+    // startup; the simulation thread only reaches the renderer through snapshots.
+    InfoPanel infoPanelView;         // Info panel state from the snapshot; textures belong to infoPanel
+    auto renderFrame = [&](const SceneSnapshot &snapshot)
     {
-        // Update timing
-        float dt = glfwGetTime() - lastFrameTime;
-        lastFrameTime += dt;
-
-
-        // Handle pause input
-        if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS)
-        {
-            if (!wasSpacePressed)
-            {
-                isPaused = !isPaused;
-                wasSpacePressed = true;
-            }
-        }
-        else
-        {
-            wasSpacePressed = false;
-        }
-
-        // Time speed controls
-        if (glfwGetKey(window, GLFW_KEY_EQUAL) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_KP_ADD) == GLFW_PRESS)
-        {
-            if (!wasEqualPressed)
-            {
-                timeSpeed *= 1.5f; // Increase speed by 50%
-                if (timeSpeed > 10.0f)
-                    timeSpeed = 10.0f; // Cap at 10x speed
-                std::cout << "Time speed: " << timeSpeed << "x" << std::endl;
-                wasEqualPressed = true;
-            }
-        }
-        else
-        {
-            wasEqualPressed = false;
-        }
+        gpuProfiler.beginFrame();
+        GLState::resetCounters();
 
-        if (glfwGetKey(window, GLFW_KEY_MINUS) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_KP_SUBTRACT) == GLFW_PRESS)
-        {
-            if (!wasMinusPressed)
-            {
-                timeSpeed /= 1.5f; // Decrease speed
-                if (timeSpeed < -10.0f)
-                    timeSpeed = -10.0f; // Cap reverse speed
-                std::cout << "Time speed: " << timeSpeed << "x" << std::endl;
-                wasMinusPressed = true;
-            }
-        }
-        else
+        // The overlay follows the simulation thread's F1 state
+        if (profilerOverlay.visible != snapshot.profilerOverlayVisible)
         {
-            wasMinusPressed = false;
+            profilerOverlay.toggle();
         }
 
-        if (glfwGetKey(window, GLFW_KEY_9) == GLFW_PRESS)
-        {
-            if (!wasTPressed)
-            {
-                timeSpeed *= -1.0f; // Reverse time direction
-                std::cout << "Time " << (timeSpeed < 0 ? "reversed" : "forward") << " at " << abs(timeSpeed)
-                          << "x speed" << std::endl;
-                wasTPressed = true;
-            }
-        }
-        else
+        // Adapt quality to the last frame's CPU and newest GPU times, and the scene resolution to the GPU time
+        double renderStartUs = profiler.nowUs();
+        bool resized = qualityGovernor.addSample(std::max(lastRenderMs, gpuProfiler.lastFrameMs)) &&
+                       dynamicResolution.setScaleLimit(quality.renderScaleLimit);
+        if (gpuProfiler.timedFrames != timedFrames)
         {
-            wasTPressed = false;
+            timedFrames = gpuProfiler.timedFrames;
+            resized = dynamicResolution.update(gpuProfiler.lastFrameMs) || resized;
         }
-
-        // Reset to normal speed
-        if (glfwGetKey(window, GLFW_KEY_0) == GLFW_PRESS)
+        if (resized)
         {
-            timeSpeed = 1.0f;
-            std::cout << "Time speed reset to normal" << std::endl;
-        }
-
-        // Planet size comparison mode
-        if (glfwGetKey(window, GLFW_KEY_C) == GLFW_PRESS)
-        {
-            if (!wasCPressed)
-            {
-                comparisonMode = !comparisonMode;
-                if (comparisonMode)
-                {
-                    std::cout << "Planet size comparison mode ON - Press C again to return to orbit mode" << std::endl;
-                }
-                else
-                {
-                    std::cout << "Returned to normal orbit mode" << std::endl;
-                }
-                wasCPressed = true;
-            }
-        }
-        else
-        {
-            wasCPressed = false;
-        }
-
-
-        // Handle planet selection with key 3
-        if (glfwGetKey(window, GLFW_KEY_3) == GLFW_PRESS)
-        {
-            if (!planetSelector.was3Pressed)
-            {
-                if (!planetSelectionMode)
-                {
-                    // Enter planet selection mode
-                    planetSelectionMode = true;
-                    camera.firstPerson = false; // Switch to third person for better planet viewing
-                    cout << "Entered planet selection mode. Press 'I' to show planet info. Selected: "
-                         << planetSelector.getSelectedName() << endl;
-                }
-                else
-                {
-                    // Cycle to next planet
-                    planetSelector.nextSelection();
-                    // If info panel is currently visible, update it with new planet info
-                    if (infoPanel.visible)
-                    {
-                        infoPanel.show(planetSelector.getSelectedInfo());
-                    }
-                    cout << "Selected: " << planetSelector.getSelectedName() << " (Press 'I' for info)" << endl;
-                }
-                planetSelector.was3Pressed = true;
-            }
-        }
-        else
-        {
-            planetSelector.was3Pressed = false;
-        }
-
-        // Exit planet selection mode with key 4
-        if (glfwGetKey(window, GLFW_KEY_4) == GLFW_PRESS)
-        {
-            if (planetSelectionMode)
-            {
-                planetSelectionMode = false;
-                infoPanel.hide(); // Hide info panel when exiting
-                cout << "Exited planet selection mode" << endl;
-            }
-        }
-
-        // Handle 'I' key for showing/hiding planet info (only in planet selection mode)
-        if (planetSelectionMode)
-        {
-            infoPanel.handleInput(window, planetSelector.getSelectedInfo());
-        }
-
-        // Update info panel
-        infoPanel.update(dt);
-
-        // X and R key handling for black hole effect
-        // X key to activate black hole
-        if (glfwGetKey(window, GLFW_KEY_X) == GLFW_PRESS)
-        {
-            if (!wasXPressed && !blackHole.active)
-            {
-                blackHole.active = true;
-                blackHole.activationTime = glfwGetTime();
-                std::cout << "Black hole activated!" << std::endl;
-
-                // CRITICAL FIX: Capture CURRENT positions when X is pressed, not stored positions
-                blackHole.originalPositions.clear();
-                blackHole.originalScales.clear();
-                blackHole.originalPositions.push_back(sun.position); // Current sun position
-                blackHole.originalScales.push_back(sun.scale);
-                blackHole.originalPositions.push_back(mercury.position); // Current mercury position
-                blackHole.originalScales.push_back(mercury.scale);
-                blackHole.originalPositions.push_back(venus.position); // Current venus position
-                blackHole.originalScales.push_back(venus.scale);
-                blackHole.originalPositions.push_back(earth.position); // Current earth position
-                blackHole.originalScales.push_back(earth.scale);
-                blackHole.originalPositions.push_back(moon.position); // Current moon position
-                blackHole.originalScales.push_back(moon.scale);
-                blackHole.originalPositions.push_back(mars.position); // Current mars position
-                blackHole.originalScales.push_back(mars.scale);
-                blackHole.originalPositions.push_back(jupiter.position); // Current jupiter position
-                blackHole.originalScales.push_back(jupiter.scale);
-                blackHole.originalPositions.push_back(saturn.position); // Current saturn position
-                blackHole.originalScales.push_back(saturn.scale);
-                blackHole.originalPositions.push_back(uranus.position); // Current uranus position
-                blackHole.originalScales.push_back(uranus.scale);
-                blackHole.originalPositions.push_back(neptune.position); // Current neptune position
-                blackHole.originalScales.push_back(neptune.scale);
-
-                wasXPressed = true;
-            }
-        }
-        else
-        {
-            wasXPressed = false;
-        }
-
-        // R key to reset
-        if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS)
-        {
-            if (!wasRPressed)
-            {
-                blackHole.active = false;
-                blackHole.strength = 0.0f;
-                std::cout << "Black hole reset!" << std::endl;
-
-                // Reset all bodies to normal orbital positions (not the X-pressed positions)
-                sun.position = blackHole.resetPositions[0];
-                sun.scale = blackHole.resetScales[0];
-                mercury.position = blackHole.resetPositions[1];
-                mercury.scale = blackHole.resetScales[1];
-                venus.position = blackHole.resetPositions[2];
-                venus.scale = blackHole.resetScales[2];
-                earth.position = blackHole.resetPositions[3];
-                earth.scale = blackHole.resetScales[3];
-                moon.position = blackHole.resetPositions[4];
-                moon.scale = blackHole.resetScales[4];
-                mars.position = blackHole.resetPositions[5];
-                mars.scale = blackHole.resetScales[5];
-                jupiter.position = blackHole.resetPositions[6];
-                jupiter.scale = blackHole.resetScales[6];
-                saturn.position = blackHole.resetPositions[7];
-                saturn.scale = blackHole.resetScales[7];
-                uranus.position = blackHole.resetPositions[8];
-                uranus.scale = blackHole.resetScales[8];
-                neptune.position = blackHole.resetPositions[9];
-                neptune.scale = blackHole.resetScales[9];
-
-                wasRPressed = true;
-            }
-        }
-        else
-        {
-            wasRPressed = false;
-        }
-
-        float animationDt = isPaused ? 0.0f : dt * timeSpeed;
-
-        // Update camera for planet selection mode
-        if (planetSelectionMode)
-        {
-            CelestialBody *selectedBody = planetSelector.getSelectedBody();
-            camera.updateForSelectedPlanet(selectedBody, dt);
+            transparency.setRenderSize(dynamicResolution.renderWidth, dynamicResolution.renderHeight);
+            clusteredLights.resize(transparency.renderWidth, transparency.renderHeight);
         }
 
         // Clear buffers
+        transparency.beginScene();
+        gpuProfiler.beginPass("Clear");
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        gpuProfiler.endPass();
 
-        // Update view matrix
-        mat4 viewMatrix = camera.updateViewMatrix();
-        GLuint viewMatrixLocation = glGetUniformLocation(shaders.base, "viewMatrix");
-        glUniformMatrix4fv(viewMatrixLocation, 1, GL_FALSE, &viewMatrix[0][0]);
+        const mat4 &viewMatrix = snapshot.viewMatrix;
 
         // Render skybox
-        skybox.render(shaders.skybox, viewMatrix, projectionMatrix);
+        {
+            PROFILE_PASS(gpuProfiler, "Skybox");
+            skybox.render(shaders.skybox, viewMatrix, projectionMatrix);
+        }
 
         // Setup base shader for scene rendering
-        glUseProgram(shaders.base);
+        GLState::useProgram(shaders.base);
 
         glUniformMatrix4fv(viewMatrixLocation, 1, GL_FALSE, &viewMatrix[0][0]);
 
         glUniformMatrix4fv(projectionMatrixLocation, 1, GL_FALSE, &projectionMatrix[0][0]);
 
-        glBindVertexArray(vao);
+        GLState::bindVertexArray(vao);
 
         // Update and render spinning duck (third-person view only)
-        spinningCubeAngle += 180.0f * dt;
-        if (!camera.firstPerson && !planetSelectionMode)
+        // From the snapshot's clock, so skipped snapshots don't slow the spin down
+        float spinningCubeAngle = static_cast<float>(AngleUtils::wrap(180.0 * snapshot.clockTime, 360.0));
+        if (!snapshot.firstPerson && !snapshot.planetSelectionMode)
         {
+            PROFILE_PASS(gpuProfiler, "Duck");
             GLuint worldMatrixLocation = glGetUniformLocation(shaders.base, "worldMatrix");
 
-            mat4 spinningCubeWorldMatrix = translate(mat4(1.0f), camera.position + vec3(0.0f, -0.2f, 0.0f)) *
+            mat4 spinningCubeWorldMatrix = translate(mat4(1.0f), snapshot.cameraPosition + vec3(0.0f, -0.2f, 0.0f)) *
                                            rotate(mat4(1.0f), radians(spinningCubeAngle), vec3(0.0f, 1.0f, 0.0f)) *
                                            rotate(mat4(1.0f), radians(1.0f), vec3(0.0f, 0.0f, 1.0f)) *
                                            scale(mat4(1.0f), vec3(0.0006f, 0.0006f, 0.0006f));
@@ -538,358 +437,306 @@ int main(int argc, char *argv[])
 
             if (!duckModel.meshes.empty())
             {
-                glDisable(GL_CULL_FACE);
+                GLState::disable(GL_CULL_FACE);
                 duckModel.Draw(shaders.base);
-                glEnable(GL_CULL_FACE);
+                GLState::enable(GL_CULL_FACE);
             }
         }
 
-        // Update celestial body positions and handle black hole effect
-        orbAngle += 20.0f * animationDt;
-        vec3 sunPosition = vec3(0.0f, 0.0f, -20.0f);
+        // Record celestial bodies, rings and comets, then draw them sorted by pass and state
+        profiler.beginScope("Record");
+        sceneRenderer.record(snapshot, shaders, quality, renderQueue);
+        profiler.endScope();
+        profiler.beginScope("Light binning");
+        clusteredLights.update(snapshot.lightPositions, snapshot.lights, viewMatrix, projectionMatrix);
+        profiler.endScope();
+        FrameUniforms frameUniforms{viewMatrix,
+                                    projectionMatrix,
+                                    snapshot.cameraPosition,
+                                    &snapshot.shadowPositions,
+                                    &snapshot.shadowRadii,
+                                    quality.shadowCasterCount(snapshot.shadowPositions.size()),
+                                    sceneRenderer.atmospheres.texture,
+                                    &clusteredLights};
+        renderQueue.submit(frameUniforms, gpuProfiler, transparency);
 
-        // FIXED: Proper black hole effect implementation
-        if (blackHole.active)
+        // Render selection indicator if in planet selection mode
+        if (snapshot.hasSelection)
         {
-            float elapsed = glfwGetTime() - blackHole.activationTime;
-            float effectDuration = 6.0f; // 6 second effect for better visibility
-            blackHole.strength = std::min(1.0f, elapsed / effectDuration);
+            PROFILE_PASS(gpuProfiler, "Selection");
+            selectionRenderer.render(snapshot.selectedBody, shaders.selection, viewMatrix, projectionMatrix);
+        }
 
-            // Apply black hole effect to all bodies - shrink to COMPLETELY INVISIBLE
-            float shrinkFactor =
-                std::max(0.0f, 1.0f - blackHole.strength); // Goes from 1.0 to 0.0 (completely invisible)
+        // The 3D scene is done; overlays draw straight into the window at full resolution
+        {
+            PROFILE_PASS(gpuProfiler, "Blit");
+            transparency.present();
+        }
 
-            // Linear interpolation function
-            auto lerp = [](const vec3 &a, const vec3 &b, float t) -> vec3 { return a + t * (b - a); };
+        // Render info panel and profiler overlay if visible
+        {
+            PROFILE_PASS(gpuProfiler, "UI");
+            if (snapshot.planetSelectionMode && snapshot.infoPanelVisible)
+            {
+                infoPanelView.fadeAlpha = snapshot.infoPanelAlpha;
+                infoPanelView.currentTexture = snapshot.infoPanelTexture;
+                infoPanelView.renderOnScreen(shaders.ui, 800, 600);
+            }
+            profilerOverlay.render(shaders.hud, 800, 600);
+        }
 
-            // Apply effect to ALL bodies including the sun - they all go to the black hole center
-            sun.position = lerp(blackHole.originalPositions[0], blackHole.position, blackHole.strength);
-            sun.scale = blackHole.originalScales[0] * shrinkFactor;
+        gpuProfiler.endFrame();
+        lastRenderMs = static_cast<float>((profiler.nowUs() - renderStartUs) / 1000.0);
 
-            mercury.position = lerp(blackHole.originalPositions[1], blackHole.position, blackHole.strength);
-            mercury.scale = blackHole.originalScales[1] * shrinkFactor;
+        // Swap buffers
+        {
+            PROFILE_SCOPE("Present");
+            glfwSwapBuffers(window);
+        }
+    };
 
-            venus.position = lerp(blackHole.originalPositions[2], blackHole.position, blackHole.strength);
-            venus.scale = blackHole.originalScales[2] * shrinkFactor;
+    // Snapshots from the simulation to the renderer. A render thread owns the GL context and
+    // draws the newest snapshot while the main thread polls input and simulates the next one.
+    // Perf scenarios stay on one thread so their frame times cover simulation and rendering.
+    TripleBuffer<SceneSnapshot> snapshots;
+    bool threaded = !perfMode && !singleThread;
+    std::atomic<bool> stopRendering(false);
+    std::atomic<unsigned int> publishedFrames(0); // Bumped and notified with every snapshot
+    std::thread renderThread;
+    auto frameInterval = std::chrono::microseconds(1000000 / 60);
+    if (threaded)
+    {
+        // Simulate at the display's refresh rate; the render thread waits for vsync
+        const GLFWvidmode *mode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+        if (mode && mode->refreshRate > 0)
+        {
+            frameInterval = std::chrono::microseconds(1000000 / mode->refreshRate);
+        }
+        glfwSwapInterval(1);
+        glfwMakeContextCurrent(nullptr);
+        renderThread = std::thread([&]()
+        {
+            glfwMakeContextCurrent(window);
+            Profiler::setThreadTrack(Profiler::RENDER);
+            while (!stopRendering.load(std::memory_order_acquire))
+            {
+                unsigned int published = publishedFrames.load(std::memory_order_acquire);
+                if (!snapshots.update())
+                {
+                    // Sleep until the next publish (or shutdown) instead of polling
+                    publishedFrames.wait(published, std::memory_order_acquire);
+                    continue;
+                }
+                renderFrame(snapshots.readSlot());
+            }
+            glfwMakeContextCurrent(nullptr);
+        });
+    }
 
-            earth.position = lerp(blackHole.originalPositions[3], blackHole.position, blackHole.strength);
-            earth.scale = blackHole.originalScales[3] * shrinkFactor;
+    // Initialize timing and input state
+    float lastFrameTime = glfwGetTime();
+    GlfwInput glfwInput;
+    bool profilerOverlayVisible = false;
+    auto nextFrame = std::chrono::steady_clock::now();
+
+    // Idle mode: once the scene is paused and nothing has moved for a moment, the window keeps
+    // showing the last frame and both threads sleep until an event arrives. Recordings, replays
+    // and perf runs keep their frame-by-frame timing.
+    const int idleAfterFrames = 30;
+    bool idleAllowed = idleMode && !perfMode && !replayer.isOpen() && !recorder.isOpen();
+    int stillFrames = 0;
+    mat4 lastViewMatrix(0.0f);
+
+    if (traceFromStartup)
+    {
+        profiler.startCapture();
+    }
 
-            moon.position = lerp(blackHole.originalPositions[4], blackHole.position, blackHole.strength);
-            moon.scale = blackHole.originalScales[4] * shrinkFactor;
 
-            mars.position = lerp(blackHole.originalPositions[5], blackHole.position, blackHole.strength);
-            mars.scale = blackHole.originalScales[5] * shrinkFactor;
+    // Main loop
+    while (!glfwWindowShouldClose(window))
+    {
+        double frameStartTime = glfwGetTime();
+        profiler.beginFrame();
 
-            jupiter.position = lerp(blackHole.originalPositions[6], blackHole.position, blackHole.strength);
-            jupiter.scale = blackHole.originalScales[6] * shrinkFactor;
+        profiler.beginScope("Input");
 
-            saturn.position = lerp(blackHole.originalPositions[7], blackHole.position, blackHole.strength);
-            saturn.scale = blackHole.originalScales[7] * shrinkFactor;
+        // Poll events even when replaying so the window stays responsive
+        glfwPollEvents();
 
-            uranus.position = lerp(blackHole.originalPositions[8], blackHole.position, blackHole.strength);
-            uranus.scale = blackHole.originalScales[8] * shrinkFactor;
+        // Update timing
+        float dt = glfwGetTime() - lastFrameTime;
+        lastFrameTime += dt;
 
-            neptune.position = lerp(blackHole.originalPositions[9], blackHole.position, blackHole.strength);
-            neptune.scale = blackHole.originalScales[9] * shrinkFactor;
+        FrameInput liveInput = glfwInput.poll(window, lastFrameTime, dt);
+        FrameInput input = liveInput;
+        if (replayer.isOpen() && !replayer.next(input))
+        {
+            profiler.endScope();
+            profiler.endFrame();
+            break;
+        }
+        if (perfMode)
+        {
+            input = perfScenario.input(perfFrame);
+        }
+        dt = input.dt;
+        recorder.write(input);
 
-            // Don't do normal orbital updates during black hole effect - COMPLETELY override positions
+        // Profiler overlay and trace capture toggles
+        if (input.pressed(Key::F1))
+        {
+            profilerOverlayVisible = !profilerOverlayVisible;
         }
-        else
+
+        if (input.pressed(Key::F2))
         {
-            // Check if we're in comparison mode
-            if (comparisonMode)
+            if (profiler.isCapturing())
             {
-                // Position planets in a straight line by size: smallest to largest
-                // Position sun slightly to the side so it doesn't block planets
-                sun.position = vec3(-15.0f, 0.0f, -20.0f);
-
-                // Line up planets by size from smallest to largest, moving away from sun
-                // Position them so sun light can reach all of them (no shadows)
-
-                float baseSpacing = 8.0f;    // Base distance between each planet
-                float saturnExtra = 4.0f;    // Extra spacing around Saturn for rings
-                float startDistance = 5.0f;   // Distance from sun position to first planet
-                
-                // Calculate positions with extra space around Saturn
-                mercury.position = vec3(startDistance, 0, -20);               // 0.11f - Smallest
-                mars.position = vec3(startDistance + baseSpacing * 1, 0, -20);    // 0.16f - Mars is smaller than Earth!
-                venus.position = vec3(startDistance + baseSpacing * 2, 0, -20);   // 0.28f
-                earth.position = vec3(startDistance + baseSpacing * 3, 0, -20);   // 0.3f
-                moon.position = vec3(startDistance + baseSpacing * 3.3f, 2, -20); // Moon near Earth
-                neptune.position = vec3(startDistance + baseSpacing * 4, 0, -20); // 1.17f - Neptune is smaller than Uranus!
-                uranus.position = vec3(startDistance + baseSpacing * 5, 0, -20);  // 1.2f
-                saturn.position = vec3(startDistance + baseSpacing * 6 + saturnExtra, 0, -20);  // 2.82f - Extra space for rings
-                jupiter.position = vec3(startDistance + baseSpacing * 7 + saturnExtra * 2.5, 0, -20); // 3.36f - Largest
-
-                // Still allow rotation in comparison mode
-                sun.rotationAngle += sun.rotationSpeed * animationDt;
-                mercury.rotationAngle += mercury.rotationSpeed * animationDt;
-                venus.rotationAngle += venus.rotationSpeed * animationDt;
-                earth.rotationAngle += earth.rotationSpeed * animationDt;
-                mars.rotationAngle += mars.rotationSpeed * animationDt;
-                jupiter.rotationAngle += jupiter.rotationSpeed * animationDt;
-                saturn.rotationAngle += saturn.rotationSpeed * animationDt;
-                uranus.rotationAngle += uranus.rotationSpeed * animationDt;
-                neptune.rotationAngle += neptune.rotationSpeed * animationDt;
-                moon.rotationAngle += moon.rotationSpeed * animationDt;
+                profiler.stopCapture(tracePath);
             }
             else
             {
-                // Normal celestial body updates only when black hole is not active
-                sun.update(sun.position, orbAngle, animationDt);
-                mercury.update(sun.position, orbAngle, animationDt);
-                venus.update(sun.position, orbAngle, animationDt);
-                earth.update(sun.position, orbAngle, animationDt);
-                mars.update(sun.position, orbAngle, animationDt);
-                jupiter.update(sun.position, orbAngle, animationDt);
-                saturn.update(sun.position, orbAngle, animationDt);
-                uranus.update(sun.position, orbAngle, animationDt);
-                neptune.update(sun.position, orbAngle, animationDt);
-                moon.update(earth.position, orbAngle, animationDt);
+                profiler.startCapture();
             }
         }
-        // Update comets
-		halleysComet.update(animationDt, sun.position);
-        comet2.update(animationDt, sun.position);
-
-        // Collect all planet positions and radii for shadow calculations
-        vector<vec3> planetPositions;
-        vector<float> planetRadii;
-        
-        if (!comparisonMode) {
-            planetPositions = {
-                mercury.position,
-                venus.position,
-                earth.position,
-                mars.position,
-                jupiter.position,
-                saturn.position,
-                uranus.position,
-                neptune.position,
-                moon.position
-            };
-            planetRadii = {
-                mercury.scale.x,
-                venus.scale.x,
-                earth.scale.x,
-                mars.scale.x,
-                jupiter.scale.x,
-                saturn.scale.x,
-                uranus.scale.x,
-                neptune.scale.x,
-                moon.scale.x
-            };
-        }
-
-        // Render all celestial bodies in order from sun outward - BUT ONLY IF VISIBLE
-        // Check if each body is large enough to be visible (scale > 0.01f means visible)
-
-        if (sun.scale.x > 0.01f)
-        {
-            sun.render(shaders.orb, viewMatrix, projectionMatrix, sun.position, camera.position, true);
-        }
-        if (mercury.scale.x > 0.01f)
-        {
-            mercury.render(shaders.orb,
-                         viewMatrix,
-                         projectionMatrix,
-                         sun.position,
-                         camera.position,
-                         false,
-                         planetPositions,
-                         planetRadii);
-        }
-        if (venus.scale.x > 0.01f)
-        {
-            venus.render(shaders.orb,
-                        viewMatrix,
-                        projectionMatrix,
-                        sun.position,
-                        camera.position,
-                        false,
-                        planetPositions,
-                        planetRadii);
-        }
-        if (earth.scale.x > 0.01f)
-        {
-            earth.render(shaders.orb,
-                        viewMatrix,
-                        projectionMatrix,
-                        sun.position,
-                        camera.position,
-                        false,
-                        planetPositions,
-                        planetRadii);
-        }
-        if (mars.scale.x > 0.01f)
-        {
-            mars.render(shaders.orb,
-                       viewMatrix,
-                       projectionMatrix,
-                       sun.position,
-                       camera.position,
-                       false,
-                       planetPositions,
-                       planetRadii);
-        }
-        if (jupiter.scale.x > 0.01f)
-        {
-            jupiter.render(shaders.orb,
-                         viewMatrix,
-                         projectionMatrix,
-                         sun.position,
-                         camera.position,
-                         false,
-                         planetPositions,
-                         planetRadii);
-        }
-        if (saturn.scale.x > 0.01f)
-        {
-            saturn.render(shaders.orb,
-                         viewMatrix,
-                         projectionMatrix,
-                         sun.position,
-                         camera.position,
-                         false,
-                         planetPositions,
-                         planetRadii);
-        }
-        // Render Saturn's rings immediately after Saturn only if Saturn is visible
-        if (saturn.scale.x > 0.01f) {
-            saturnRings.render(saturn, shaders.orb, viewMatrix, projectionMatrix, sun.position, camera.position);
-        }
-        if (uranus.scale.x > 0.01f)
-        {
-            uranus.render(shaders.orb,
-                         viewMatrix,
-                         projectionMatrix,
-                         sun.position,
-                         camera.position,
-                         false,
-                         planetPositions,
-                         planetRadii);
-        }
-        if (neptune.scale.x > 0.01f)
-        {
-            neptune.render(shaders.orb,
-                          viewMatrix,
-                          projectionMatrix,
-                          sun.position,
-                          camera.position,
-                          false,
-                          planetPositions,
-                          planetRadii);
-        }
-        if (moon.scale.x > 0.01f)
-        {
-            moon.render(shaders.orb,
-                       viewMatrix,
-                       projectionMatrix,
-                       sun.position,
-                       camera.position,
-                       false,
-                       planetPositions,
-                       planetRadii);
-        }
-
-        // Render comet trails first (so they appear behind comet heads)
-        halleysComet.renderTrail(shaders.base, viewMatrix, projectionMatrix);
-        
-        comet2.renderTrail(shaders.base, viewMatrix, projectionMatrix);        // Render comet heads
-        halleysComet.body.render(shaders.orb,
-                                  viewMatrix,
-                                  projectionMatrix,
-                                  sun.position,
-                                  camera.position,
-                                  false,
-                                  planetPositions,
-                                  planetRadii);
-        comet2.body.render(shaders.orb,
-                          viewMatrix,
-                          projectionMatrix,
-                          sun.position,
-                          camera.position,
-                          false,
-                          planetPositions,
-                          planetRadii);
 
-        // Render selection indicator if in planet selection mode
-        if (planetSelectionMode)
+        // Escape on the real keyboard also stops a replay
+        if (input.isDown(Key::Escape) || liveInput.isDown(Key::Escape))
         {
-            CelestialBody *selectedBody = planetSelector.getSelectedBody();
-            planetSelector.renderSelectionIndicator(shaders.selection, viewMatrix, projectionMatrix);
+            glfwSetWindowShouldClose(window, true);
         }
 
-        // Render info panel if visible
-        if (planetSelectionMode && infoPanel.visible)
+        // Pause, time speed, comparison mode, black hole and planet selection
+        int previousSelection = planetSelector.selectedIndex;
+        bool wasSelecting = scene.planetSelectionMode;
+        scene.handleInput(input);
+
+        // Keep the info panel in sync with the selection
+        if (wasSelecting && !scene.planetSelectionMode)
         {
-            infoPanel.renderOnScreen(shaders.ui, 800, 600);
+            infoPanel.hide(); // Hide info panel when exiting
+        }
+        if (planetSelector.selectedIndex != previousSelection && infoPanel.visible)
+        {
+            infoPanel.show(planetSelector.getSelectedInfo());
         }
 
-        // Swap buffers and poll events
-        glfwSwapBuffers(window);
-        glfwPollEvents();
-
-        // Handle keyboard input
-        if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        // Handle 'I' key for showing/hiding planet info (only in planet selection mode)
+        if (scene.planetSelectionMode)
         {
-            glfwSetWindowShouldClose(window, true);
+            infoPanel.handleInput(input, planetSelector.getSelectedInfo());
         }
 
-        // Only allow manual camera mode switching when not in planet selection mode
-        if (!planetSelectionMode)
+        // Update info panel
+        infoPanel.update(dt);
+
+        profiler.endScope();
+
+        // Update celestial bodies, comets and the camera
+        scene.updateSimulation(input);
+        scene.updateCamera(input);
+        if (perfMode && perfScenario.scriptedCamera)
         {
-            if (glfwGetKey(window, GLFW_KEY_1) == GLFW_PRESS)
-            {
-                camera.firstPerson = true;
-            }
-            if (glfwGetKey(window, GLFW_KEY_2) == GLFW_PRESS)
-            {
-                camera.firstPerson = false;
-            }
+            perfScenario.cameraPose(perfFrame, camera.position, camera.lookAt);
         }
 
-        // Update camera from mouse input (only when not in planet selection mode)
-        if (!planetSelectionMode)
+        // Hand the frame to the renderer
+        profiler.beginScope("Snapshot");
+        SceneSnapshot &snapshot = snapshots.writeSlot();
+        snapshot.capture(scene);
+        snapshot.infoPanelVisible = infoPanel.visible;
+        snapshot.infoPanelAlpha = infoPanel.fadeAlpha;
+        snapshot.infoPanelTexture = infoPanel.currentTexture;
+        snapshot.profilerOverlayVisible = profilerOverlayVisible;
+        bool cameraMoved = snapshot.viewMatrix != lastViewMatrix;
+        lastViewMatrix = snapshot.viewMatrix;
+        snapshots.publish();
+        publishedFrames.fetch_add(1, std::memory_order_release);
+        publishedFrames.notify_one();
+        profiler.endScope();
+
+        if (!threaded)
         {
-            double mousePosX, mousePosY;
-            glfwGetCursorPos(window, &mousePosX, &mousePosY);
-            double dx = mousePosX - lastMousePosX;
-            double dy = mousePosY - lastMousePosY;
-            lastMousePosX = mousePosX;
-            lastMousePosY = mousePosY;
+            snapshots.update();
+            renderFrame(snapshots.readSlot());
+        }
 
-            camera.updateAngles(static_cast<float>(dx), static_cast<float>(dy), dt);
-            camera.updatePosition(window, dt);
+        profiler.endFrame();
 
-            // Handle arrow key camera control
-            const float arrowLookSpeed = 60.0f;
-            if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS)
-            {
-                camera.horizontalAngle += arrowLookSpeed * dt;
-            }
-            if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS)
+        // Perf scenarios measure whole frames, including the swap, after the warm-up
+        if (perfMode)
+        {
+            if (perfFrame >= perfScenario.warmupFrames)
             {
-                camera.horizontalAngle -= arrowLookSpeed * dt;
+                perfReport.addFrame((glfwGetTime() - frameStartTime) * 1000.0,
+                                    GLState::counters.drawCalls,
+                                    GLState::counters.stateChanges,
+                                    GLState::counters.elidedChanges);
             }
-            if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS)
+            if (++perfFrame >= perfScenario.warmupFrames + perfScenario.frameCount)
             {
-                camera.verticalAngle += arrowLookSpeed * dt;
+                break;
             }
-            if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS)
+        }
+
+        // Nothing on screen changes until input: no keys held, no camera motion, no fades or overlay graphs
+        bool still = idleAllowed && !scene.isAnimating() && input.keys == 0 && !cameraMoved &&
+                     !infoPanel.isFading() && !profilerOverlayVisible;
+        stillFrames = still ? stillFrames + 1 : 0;
+        if (stillFrames >= idleAfterFrames)
+        {
+            // Any event wakes us: input, or the window being exposed or resized and needing a redraw.
+            // Time spent waiting is skipped, as if the app had been paused with no clock at all.
+            glfwWaitEvents();
+            lastFrameTime = glfwGetTime();
+            nextFrame = std::chrono::steady_clock::now();
+        }
+        // Without a swap to wait on, pace the simulation to the display
+        else if (threaded)
+        {
+            nextFrame += frameInterval;
+            auto now = std::chrono::steady_clock::now();
+            if (nextFrame < now)
             {
-                camera.verticalAngle -= arrowLookSpeed * dt;
+                nextFrame = now;
             }
-
-            // Update camera look direction based on angles
-            float theta = radians(camera.horizontalAngle);
-            float phi = radians(camera.verticalAngle);
-            camera.lookAt = vec3(cos(phi) * cos(theta), sin(phi), -cos(phi) * sin(theta));
+            std::this_thread::sleep_until(nextFrame);
         }
     }
 
+    if (threaded)
+    {
+        stopRendering.store(true, std::memory_order_release);
+        publishedFrames.fetch_add(1, std::memory_order_release);
+        publishedFrames.notify_one();
+        renderThread.join();
+        glfwMakeContextCurrent(window);
+    }
+
+    if (profiler.isCapturing())
+    {
+        profiler.stopCapture(tracePath);
+    }
+
+    recorder.close();
+    if (replayer.isOpen())
+    {
+        std::cout << "Replayed " << replayer.framesPlayed() << " frames, state checksum " << std::hex
+                  << scene.stateChecksum() << std::dec << std::endl;
+    }
+
+    int exitCode = 0;
+    if (perfMode)
+    {
+        perfReport.setPeakResidentBytes(MemoryUtils::peakResidentBytes());
+        perfReport.setGpuFrameMs(profiler.averageGpuFrameMs());
+        exitCode = perfReport.write(perfOutPath) ? 0 : 1;
+        std::cout << "Perf scenario " << perfScenario.name << ": " << perfReport.frameCount() << " frames, report "
+                  << perfOutPath << std::endl;
+    }
+
     // Cleanup
     glfwTerminate();
-    return 0;
+    return exitCode;
 }
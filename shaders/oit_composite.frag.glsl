@@ -0,0 +1,19 @@
+#version 330 core
+out vec4 FragColor;
+
+uniform sampler2D accumulation;  // rgb: sum of color * alpha * weight, a: revealage
+uniform sampler2D weight;        // Sum of alpha * weight
+
+void main()
+{
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    vec4 accum = texelFetch(accumulation, texel, 0);
+    float revealage = accum.a;
+    if (revealage >= 1.0) {
+        discard;  // Nothing translucent covers this pixel
+    }
+    vec3 average = accum.rgb / max(texelFetch(weight, texel, 0).r, 1e-5);
+
+    // Blended with (1 - alpha, alpha): average * (1 - revealage) + scene * revealage
+    FragColor = vec4(average, revealage);
+}
@@ -1,40 +1,69 @@
 #version 330 core
+// Compiled once per material (ShaderPrograms::sphere), with any of:
+//   SUN         self-illuminating with a rim glow, no lighting
+//   ATMOSPHERE  scattering from the body's atmosphere, read from AtmosphereTable
+//   SHADOWS     darkened where another body blocks the light
+//   OIT         written to the weighted blended transparency targets (TransparencyPass)
+// With none of them the surface is only lit, as for rings and airless bodies. Everything but
+// SUN is lit by the lights ClusteredLights binned into the fragment's cluster.
 in vec2 TexCoord;
 in vec3 FragPos;
 in vec3 Normal;
 
+#ifdef OIT
+layout (location = 0) out vec4 Accumulation;
+layout (location = 1) out vec4 Weight;
+#else
 out vec4 FragColor;
+#endif
 
 uniform sampler2D texture1;
-uniform vec3 lightPos;      // Sun's position
 uniform vec3 viewPos;       // Camera position
-uniform bool isSun;         // Whether this object is the sun
 
+#ifndef SUN
+// Lights binned into view-space clusters (ClusteredLights)
+uniform samplerBuffer lights;          // Per light: position and range, then color
+uniform usamplerBuffer clusterGrid;    // Per cluster: first index into clusterLights, light count
+uniform usamplerBuffer clusterLights;  // Light indices, grouped by cluster
+uniform ivec3 clusterCounts;           // Tiles across, tiles down, depth slices
+uniform vec2 clusterTileSize;          // Pixels per tile
+uniform vec2 clusterDepthSlicing;      // slice = log(view depth) * x + y
+
+// First index into clusterLights and count for the cluster this fragment lies in
+uvec2 clusterRange() {
+    float depth = 1.0 / gl_FragCoord.w;
+    ivec2 tile = min(ivec2(gl_FragCoord.xy / clusterTileSize), clusterCounts.xy - 1);
+    int slice = clamp(int(log(depth) * clusterDepthSlicing.x + clusterDepthSlicing.y), 0, clusterCounts.z - 1);
+    return texelFetch(clusterGrid, (slice * clusterCounts.y + tile.y) * clusterCounts.x + tile.x).xy;
+}
+
+// Full strength near the light, fading smoothly to nothing at its range
+float lightFalloff(float distanceToLight, float range) {
+    float fade = clamp(1.0 - pow(distanceToLight / range, 4.0), 0.0, 1.0);
+    return fade * fade;
+}
+#endif
+
+#ifdef SHADOWS
 // Shadow casting uniforms
 #define MAX_PLANETS 9
 uniform vec3 planetPositions[MAX_PLANETS];  // Positions of all planets
 uniform float planetRadii[MAX_PLANETS];     // Radii of all planets
 uniform int numPlanets;                     // Number of planets
 
-bool isInShadow() {
-    if (isSun) return false;
-    if (numPlanets == 0) return false;  // No shadow in comparison mode
-    
-    vec3 lightDir = normalize(lightPos - FragPos);
-    float distanceToLight = length(lightPos - FragPos);
-    
+bool isInShadow(vec3 lightDir, float distanceToLight) {
     // Check each planet for potential shadowing
     for (int i = 0; i < numPlanets; i++) {
         vec3 planetToFragment = FragPos - planetPositions[i];
         float planetRadius = planetRadii[i];
-        
+
         // Skip if this is our own planet
         if (length(planetToFragment) < planetRadius * 1.1) continue;
-        
+
         // Calculate closest point on ray to planet center
         float t = dot(lightDir, planetPositions[i] - FragPos);
         vec3 closestPoint = FragPos + lightDir * t;
-        
+
         // Check if closest point is between fragment and light
         if (t > 0 && t < distanceToLight) {
             float dist = length(closestPoint - planetPositions[i]);
@@ -45,73 +74,89 @@ bool isInShadow() {
     }
     return false;
 }
+#endif
 
-vec3 getAtmosphereColor(vec2 texCoord) {
-    // Sample the texture to determine planet type based on dominant colors
-    vec4 texColor = texture(texture1, texCoord);
-    
-    // Earth - blue atmosphere
-    if (texColor.b > 0.3 && texColor.g > 0.3) {
-        return vec3(0.3, 0.6, 1.0); // Light blue
-    }
-    // Mars - thin reddish atmosphere
-    else if (texColor.r > texColor.g && texColor.r > texColor.b) {
-        return vec3(1.0, 0.4, 0.2); // Orange-red
-    }
-    // Venus - thick yellowish atmosphere
-    else if (texColor.r > 0.6 && texColor.g > 0.6 && texColor.b < 0.3) {
-        return vec3(1.0, 0.8, 0.3); // Yellow-orange
-    }
-    // Gas giants - use dominant color with slight blue tint
-    else {
-        return mix(texColor.rgb, vec3(0.5, 0.7, 1.0), 0.3);
-    }
+#ifdef ATMOSPHERE
+uniform sampler2D atmosphereTable;  // AtmosphereTable: one row per atmosphere, cos(view angle) across
+uniform float atmosphereRow;        // This body's row
+
+// Light scattered by the atmosphere towards the camera, per unit of sunlight
+vec4 atmosphereScattering(float viewCos) {
+    float width = float(textureSize(atmosphereTable, 0).x);
+    float u = (viewCos * (width - 1.0) + 0.5) / width;  // Texel centers hold cos 0 and 1
+    return texture(atmosphereTable, vec2(u, atmosphereRow));
+}
+#endif
+
+#ifdef OIT
+// Add a translucent color; the weight falls off with view distance so that nearer
+// surfaces dominate the average (same function as trail.frag.glsl)
+void writeTransparent(vec3 color, float alpha) {
+    float distance = 1.0 / gl_FragCoord.w;
+    float weight = alpha * clamp(10.0 / (1e-5 + pow(distance / 5.0, 2.0) + pow(distance / 200.0, 6.0)), 1e-2, 3e3);
+    Accumulation = vec4(color * alpha * weight, alpha);
+    Weight = vec4(alpha * weight);
 }
+#endif
 
 void main() {
     vec4 texColor = texture(texture1, TexCoord);
-    
-    if (isSun) {
-        // Sun is self-illuminating with slight glow
-        vec3 normal = normalize(Normal);
-        vec3 viewDir = normalize(viewPos - FragPos);
-        float rim = 1.0 - max(dot(normal, viewDir), 0.0);
-        rim = pow(rim, 2.0);
-        
-        vec3 glowColor = vec3(1.0, 0.8, 0.4); // Warm sun glow
-        FragColor = texColor + vec4(glowColor * rim * 0.3, 0.0);
-    } else {
-        // Calculate lighting for planets
-        vec3 normal = normalize(Normal);
-        vec3 lightDir = normalize(lightPos - FragPos);
-        vec3 viewDir = normalize(viewPos - FragPos);
-        
-        // Check for shadows
-        bool shadowed = isInShadow();
-        
+    vec3 normal = normalize(Normal);
+    vec3 viewDir = normalize(viewPos - FragPos);
+
+#ifdef SUN
+    // Sun is self-illuminating with slight glow
+    float rim = 1.0 - max(dot(normal, viewDir), 0.0);
+    rim = pow(rim, 2.0);
+
+    vec3 glowColor = vec3(1.0, 0.8, 0.4); // Warm sun glow
+    FragColor = texColor + vec4(glowColor * rim * 0.3, 0.0);
+#else
+    // Ambient light (for slightly visible night side)
+    float ambientStrength = 0.1;
+    vec3 lighting = ambientStrength * vec3(1.0);
+#ifdef ATMOSPHERE
+    vec4 scattering = atmosphereScattering(max(dot(normal, viewDir), 0.0));
+    vec3 atmosphere = vec3(0.0);
+#endif
+
+    // Only the lights that reach this fragment's cluster
+    uvec2 range = clusterRange();
+    for (uint n = 0u; n < range.y; n++) {
+        int light = int(texelFetch(clusterLights, int(range.x + n)).r);
+        vec4 positionRange = texelFetch(lights, 2 * light);
+        vec3 lightColor = texelFetch(lights, 2 * light + 1).rgb;
+
+        vec3 toLight = positionRange.xyz - FragPos;
+        float distanceToLight = length(toLight);
+        vec3 lightDir = toLight / distanceToLight;
+        float falloff = lightFalloff(distanceToLight, positionRange.w);
+
         // Calculate diffuse lighting (day/night effect)
         float diff = max(dot(normal, lightDir), 0.0);
-        if (shadowed) {
+#ifdef SHADOWS
+        if (diff > 0.0 && isInShadow(lightDir, distanceToLight)) {
             diff *= 0.1; // Reduce lighting significantly in shadowed areas
         }
-        
-        // Ambient light (for slightly visible night side)
-        float ambientStrength = 0.1;
-        vec3 ambient = ambientStrength * vec3(1.0);
-        
-        // Calculate atmospheric rim lighting
-        float rim = 1.0 - max(dot(normal, viewDir), 0.0);
-        rim = pow(rim, 3.0); // Make rim more focused
-        
-        // Get atmosphere color for this planet
-        vec3 atmosphereColor = getAtmosphereColor(TexCoord);
-        
-        // Apply atmospheric glow (stronger on lit side)
-        float glowStrength = 0.4 * (0.5 + 0.5 * diff);
-        vec3 atmosphericGlow = atmosphereColor * rim * glowStrength;
-        
-        // Combine lighting with texture
-        vec3 result = (ambient + diff) * texColor.rgb + atmosphericGlow;
-        FragColor = vec4(result, texColor.a);
+#endif
+        lighting += diff * falloff * lightColor;
+
+#ifdef ATMOSPHERE
+        // Rayleigh part lit like the day side, Mie part also scattered forward when backlit
+        float forward = pow(max(dot(-viewDir, lightDir), 0.0), 8.0);
+        atmosphere += falloff * lightColor *
+                      (scattering.rgb * (0.5 + 0.5 * diff) + vec3(scattering.a * (0.5 * diff + forward)));
+#endif
     }
+
+    vec3 result = lighting * texColor.rgb;
+#ifdef ATMOSPHERE
+    result += atmosphere;
+#endif
+#ifdef OIT
+    writeTransparent(result, texColor.a);
+#else
+    FragColor = vec4(result, texColor.a);
+#endif
+#endif
 }
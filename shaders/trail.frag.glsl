@@ -0,0 +1,15 @@
+#version 330 core
+in vec4 Color;
+
+// Weighted blended transparency targets (TransparencyPass)
+layout (location = 0) out vec4 Accumulation;
+layout (location = 1) out vec4 Weight;
+
+void main()
+{
+    // Same weight as textured_sphere.frag.glsl: view distance from gl_FragCoord.w
+    float distance = 1.0 / gl_FragCoord.w;
+    float weight = Color.a * clamp(10.0 / (1e-5 + pow(distance / 5.0, 2.0) + pow(distance / 200.0, 6.0)), 1e-2, 3e3);
+    Accumulation = vec4(Color.rgb * Color.a * weight, Color.a);
+    Weight = vec4(Color.a * weight);
+}
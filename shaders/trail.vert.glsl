@@ -0,0 +1,14 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;     // World space
+layout (location = 1) in vec4 aColor;   // Alpha fades with the point's age
+
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+
+out vec4 Color;
+
+void main()
+{
+    Color = aColor;
+    gl_Position = projectionMatrix * viewMatrix * vec4(aPos, 1.0);
+}
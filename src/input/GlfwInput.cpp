@@ -0,0 +1,36 @@
+#include "include/input/GlfwInput.hpp"
+
+namespace {
+
+// GLFW key code for each Key, in enum order
+const int glfwKeys[] = {
+    GLFW_KEY_W, GLFW_KEY_A, GLFW_KEY_S, GLFW_KEY_D, GLFW_KEY_Q, GLFW_KEY_E, GLFW_KEY_LEFT_SHIFT, GLFW_KEY_RIGHT_SHIFT,
+    GLFW_KEY_LEFT, GLFW_KEY_RIGHT, GLFW_KEY_UP, GLFW_KEY_DOWN,
+    GLFW_KEY_SPACE, GLFW_KEY_EQUAL, GLFW_KEY_KP_ADD, GLFW_KEY_MINUS, GLFW_KEY_KP_SUBTRACT,
+    GLFW_KEY_0, GLFW_KEY_1, GLFW_KEY_2, GLFW_KEY_3, GLFW_KEY_4, GLFW_KEY_9,
+    GLFW_KEY_C, GLFW_KEY_I, GLFW_KEY_R, GLFW_KEY_X, GLFW_KEY_ESCAPE, GLFW_KEY_F1, GLFW_KEY_F2,
+    GLFW_KEY_LEFT_BRACKET, GLFW_KEY_RIGHT_BRACKET,
+};
+
+static_assert(sizeof(glfwKeys) / sizeof(glfwKeys[0]) == static_cast<int>(Key::Count), "glfwKeys must cover every Key");
+
+}
+
+GlfwInput::GlfwInput() : lastKeys(0) {}
+
+FrameInput GlfwInput::poll(GLFWwindow* window, float time, float dt) {
+    FrameInput input;
+    input.time = time;
+    input.dt = dt;
+    glfwGetCursorPos(window, &input.cursorX, &input.cursorY);
+
+    input.keys = 0;
+    for (int i = 0; i < static_cast<int>(Key::Count); ++i) {
+        if (glfwGetKey(window, glfwKeys[i]) == GLFW_PRESS) {
+            input.keys |= uint64_t(1) << i;
+        }
+    }
+    input.previousKeys = lastKeys;
+    lastKeys = input.keys;
+    return input;
+}
@@ -0,0 +1,73 @@
+#include "include/input/InputRecorder.hpp"
+#include <iostream>
+
+namespace {
+
+template <typename T>
+void writeValue(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+}
+
+InputRecorder::InputRecorder() : lastKeys(0), lastCursorX(0.0), lastCursorY(0.0), frames(0) {}
+
+bool InputRecorder::open(const std::string& path) {
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open input recording for writing: " << path << std::endl;
+        return false;
+    }
+    file.write(magic, sizeof(magic));
+    writeValue(file, version);
+    writeValue(file, static_cast<uint32_t>(Key::Count));
+
+    lastKeys = 0;
+    frames = 0;
+    std::cout << "Recording input to " << path << std::endl;
+    return true;
+}
+
+void InputRecorder::write(const FrameInput& input) {
+    if (!file.is_open()) {
+        return;
+    }
+
+    uint64_t changed = input.keys ^ lastKeys;
+    // The first frame always stores the cursor so replay starts from the same position
+    bool cursorMoved = frames == 0 || input.cursorX != lastCursorX || input.cursorY != lastCursorY;
+
+    uint8_t flags = (changed ? keyEventsFlag : 0) | (cursorMoved ? cursorFlag : 0);
+    writeValue(file, flags);
+    writeValue(file, input.time);
+    writeValue(file, input.dt);
+
+    if (changed) {
+        uint8_t events[static_cast<int>(Key::Count)];
+        uint8_t eventCount = 0;
+        for (int i = 0; i < static_cast<int>(Key::Count); ++i) {
+            if ((changed >> i) & 1) {
+                events[eventCount++] = static_cast<uint8_t>(i) | (((input.keys >> i) & 1) ? pressedBit : 0);
+            }
+        }
+        writeValue(file, eventCount);
+        file.write(reinterpret_cast<const char*>(events), eventCount);
+    }
+
+    if (cursorMoved) {
+        writeValue(file, input.cursorX);
+        writeValue(file, input.cursorY);
+    }
+
+    lastKeys = input.keys;
+    lastCursorX = input.cursorX;
+    lastCursorY = input.cursorY;
+    frames++;
+}
+
+void InputRecorder::close() {
+    if (file.is_open()) {
+        file.close();
+        std::cout << "Recorded " << frames << " frames of input" << std::endl;
+    }
+}
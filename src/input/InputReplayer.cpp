@@ -0,0 +1,100 @@
+#include "include/input/InputReplayer.hpp"
+#include "include/input/InputRecorder.hpp"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+InputReplayer::InputReplayer() : fixedDt(0.0f), offset(0), current{}, opened(false), frames(0) {}
+
+bool InputReplayer::open(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open input recording: " << path << std::endl;
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    char fileMagic[4];
+    uint32_t fileVersion = 0;
+    uint32_t keyCount = 0;
+    offset = 0;
+    if (!read(fileMagic, sizeof(fileMagic)) || std::memcmp(fileMagic, InputRecorder::magic, sizeof(fileMagic)) != 0 ||
+        !read(&fileVersion, sizeof(fileVersion)) || !read(&keyCount, sizeof(keyCount))) {
+        std::cerr << "Not an input recording: " << path << std::endl;
+        return false;
+    }
+    if (fileVersion != InputRecorder::version || keyCount > static_cast<uint32_t>(Key::Count)) {
+        std::cerr << "Unsupported input recording version " << fileVersion << ": " << path << std::endl;
+        return false;
+    }
+
+    current = FrameInput{};
+    frames = 0;
+    opened = true;
+    std::cout << "Replaying input from " << path << std::endl;
+    return true;
+}
+
+bool InputReplayer::next(FrameInput& input) {
+    if (!opened || offset >= data.size()) {
+        return false;
+    }
+
+    uint8_t flags = 0;
+    float time = 0.0f;
+    float dt = 0.0f;
+    if (!read(&flags, sizeof(flags)) || !read(&time, sizeof(time)) || !read(&dt, sizeof(dt))) {
+        return false;
+    }
+
+    current.previousKeys = current.keys;
+    if (flags & InputRecorder::keyEventsFlag) {
+        uint8_t eventCount = 0;
+        if (!read(&eventCount, sizeof(eventCount))) {
+            return false;
+        }
+        for (uint8_t i = 0; i < eventCount; ++i) {
+            uint8_t event = 0;
+            if (!read(&event, sizeof(event))) {
+                return false;
+            }
+            int key = event & ~InputRecorder::pressedBit;
+            if (key >= static_cast<int>(Key::Count)) {
+                return false;
+            }
+            uint64_t bit = uint64_t(1) << key;
+            if (event & InputRecorder::pressedBit) {
+                current.keys |= bit;
+            } else {
+                current.keys &= ~bit;
+            }
+        }
+    }
+    if ((flags & InputRecorder::cursorFlag) &&
+        (!read(&current.cursorX, sizeof(current.cursorX)) || !read(&current.cursorY, sizeof(current.cursorY)))) {
+        return false;
+    }
+
+    if (fixedDt > 0.0f) {
+        // Keep the recorded start time, then advance by exactly one step per frame
+        current.time = frames == 0 ? time : current.time + fixedDt;
+        current.dt = fixedDt;
+    } else {
+        current.time = time;
+        current.dt = dt;
+    }
+
+    input = current;
+    frames++;
+    return true;
+}
+
+bool InputReplayer::read(void* value, size_t size) {
+    if (data.size() - offset < size) {
+        return false;
+    }
+    std::memcpy(value, data.data() + offset, size);
+    offset += size;
+    return true;
+}
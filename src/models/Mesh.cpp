@@ -1,4 +1,5 @@
 #include "include/models/Mesh.hpp"
+#include "include/utils/GLState.hpp"
 #include <iostream>
 
 void Mesh::setupMesh() {
@@ -9,7 +10,7 @@ void Mesh::setupMesh() {
     glGenBuffers(1, &texVBO);
     glGenBuffers(1, &EBO);
 
-    glBindVertexArray(VAO);
+    GLState::bindVertexArray(VAO);
 
     // Vertex positions
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
@@ -37,5 +38,5 @@ void Mesh::setupMesh() {
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
 
-    glBindVertexArray(0);
+    GLState::bindVertexArray(0);
 }
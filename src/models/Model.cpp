@@ -1,6 +1,8 @@
 #include "include/utils/TextureUtils.hpp"
 #include "include/models/Mesh.hpp"
 #include "include/models/Model.hpp"
+#include "include/utils/GLDebug.hpp"
+#include "include/utils/GLState.hpp"
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <glm/glm.hpp>
@@ -8,11 +10,16 @@
 
 using namespace glm;
 
+const unsigned int Model::importFlags =
+    aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_FlipUVs |
+    aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices |
+    aiProcess_ValidateDataStructure | aiProcess_PreTransformVertices;
+
 void Model::Draw(GLuint shader) {
     for (const auto& mesh : meshes) {
         // Bind texture
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, mesh.texture);
+        GLState::activeTexture(GL_TEXTURE0);
+        GLState::bindTexture(GL_TEXTURE_2D, mesh.texture);
         GLint texLocation = glGetUniformLocation(shader, "texture1");
         if (texLocation == -1) {
             std::cerr << "Warning: Uniform 'texture1' not found in shader" << std::endl;
@@ -20,19 +27,14 @@ void Model::Draw(GLuint shader) {
         glUniform1i(texLocation, 0);
 
         // Draw mesh
-        glBindVertexArray(mesh.VAO);
+        GLState::bindVertexArray(mesh.VAO);
         if (mesh.indices.empty()) {
             std::cerr << "Warning: Mesh has no indices" << std::endl;
         } else {
-            glDrawElements(GL_TRIANGLES, mesh.indices.size(), GL_UNSIGNED_INT, 0);
-        }
-        glBindVertexArray(0);
-
-        // Check for OpenGL errors
-        GLenum err;
-        while ((err = glGetError()) != GL_NO_ERROR) {
-            std::cerr << "OpenGL error in Draw: " << err << std::endl;
+            GLState::drawElements(GL_TRIANGLES, mesh.indices.size(), GL_UNSIGNED_INT, 0);
         }
+        GLState::bindVertexArray(0);
+        GLDebug::checkErrors("Model::Draw");
     }
 }
 
@@ -41,10 +43,7 @@ Model Model::loadFromFile(const char* path) {
     Assimp::Importer importer;
     std::cout << "Attempting to load model from: " << path << std::endl;
 
-    const aiScene* scene = importer.ReadFile(path,
-        aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_FlipUVs |
-        aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices |
-        aiProcess_ValidateDataStructure | aiProcess_PreTransformVertices);
+    const aiScene* scene = importer.ReadFile(path, importFlags);
 
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
         std::cerr << "ERROR::ASSIMP::" << importer.GetErrorString() << std::endl;
@@ -61,7 +60,7 @@ Model Model::loadFromFile(const char* path) {
     return model;
 }
 
-void Model::processNode(Model& model, aiNode* node, const aiScene* scene) {
+void Model::processNode(Model& model, aiNode* node, const aiScene* scene, bool uploadToGPU) {
     // Process all meshes in this node
     for (unsigned int i = 0; i < node->mNumMeshes; i++) {
         aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
@@ -73,9 +72,11 @@ void Model::processNode(Model& model, aiNode* node, const aiScene* scene) {
         std::cout << "Processing mesh with " << mesh->mNumVertices << " vertices" << std::endl;
 
         Mesh newMesh;
+        newMesh.VAO = 0;
+        newMesh.texture = 0;
 
         // Load material/texture first
-        if (mesh->mMaterialIndex >= 0) {
+        if (uploadToGPU && mesh->mMaterialIndex >= 0) {
             aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
             if (material) {
                 aiString texturePath;
@@ -119,7 +120,9 @@ void Model::processNode(Model& model, aiNode* node, const aiScene* scene) {
         }
 
         if (!newMesh.vertices.empty() && !newMesh.indices.empty()) {
-            newMesh.setupMesh();
+            if (uploadToGPU) {
+                newMesh.setupMesh();
+            }
             model.meshes.push_back(newMesh);
             std::cout << "Added mesh with " << newMesh.vertices.size() << " vertices and " 
                      << newMesh.indices.size() << " indices" << std::endl;
@@ -128,6 +131,6 @@ void Model::processNode(Model& model, aiNode* node, const aiScene* scene) {
 
     // Recursively process child nodes
     for (unsigned int i = 0; i < node->mNumChildren; i++) {
-        processNode(model, node->mChildren[i], scene);
+        processNode(model, node->mChildren[i], scene, uploadToGPU);
     }
 }
@@ -0,0 +1,87 @@
+#include "include/perf/PerfReport.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+double mean(const std::vector<double>& values) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    double total = 0.0;
+    for (double value : values) {
+        total += value;
+    }
+    return total / values.size();
+}
+
+}
+
+void PerfReport::addFrame(double ms, unsigned long long draws, unsigned long long changes, unsigned long long elided) {
+    frameMs.push_back(ms);
+    drawCalls.push_back(static_cast<double>(draws));
+    stateChanges.push_back(static_cast<double>(changes));
+    elidedChanges.push_back(static_cast<double>(elided));
+}
+
+std::vector<PerfReport::Metric> PerfReport::summary() const {
+    std::vector<Metric> metrics = {
+        {"frame_p50_ms", percentile(frameMs, 50.0)},
+        {"frame_p95_ms", percentile(frameMs, 95.0)},
+        {"frame_p99_ms", percentile(frameMs, 99.0)},
+        {"frame_mean_ms", mean(frameMs)},
+        {"draw_calls", mean(drawCalls)},
+        {"state_changes", mean(stateChanges)},
+        {"state_changes_elided", mean(elidedChanges)},
+        {"peak_rss_mb", peakResidentBytes / (1024.0 * 1024.0)},
+    };
+    if (gpuFrameMs >= 0.0) {
+        metrics.push_back({"gpu_frame_ms", gpuFrameMs});
+    }
+    return metrics;
+}
+
+bool PerfReport::write(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Perf: failed to open report file: " << path << std::endl;
+        return false;
+    }
+    file << std::fixed << std::setprecision(4);
+    file << "frames " << frameMs.size() << "\n";
+    for (const Metric& metric : summary()) {
+        file << metric.name << " " << metric.value << "\n";
+    }
+    return true;
+}
+
+bool PerfReport::read(const std::string& path, std::vector<Metric>& metrics) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Perf: failed to open report file: " << path << std::endl;
+        return false;
+    }
+    metrics.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        Metric metric;
+        if (fields >> metric.name >> metric.value) {
+            metrics.push_back(metric);
+        }
+    }
+    return true;
+}
+
+double PerfReport::percentile(std::vector<double> values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * values.size()));
+    return values[std::min(values.size(), std::max<size_t>(rank, 1)) - 1];
+}
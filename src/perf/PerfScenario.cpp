@@ -0,0 +1,103 @@
+#include "include/perf/PerfScenario.hpp"
+#include "include/simulation/SceneGenerator.hpp"
+#include <cmath>
+
+using namespace glm;
+
+namespace {
+
+// Sun position of the default system, used as the flythrough's focus
+const vec3 systemCenter(0.0f, 0.0f, -20.0f);
+
+uint64_t keyBit(Key key) {
+    return uint64_t(1) << static_cast<int>(key);
+}
+
+}
+
+const std::vector<std::string>& PerfScenario::names() {
+    static const std::vector<std::string> scenarioNames = {
+        "default", "tour", "blackhole", "synthetic_10k", "synthetic_100k"};
+    return scenarioNames;
+}
+
+bool PerfScenario::find(const std::string& name, PerfScenario& scenario) {
+    scenario.name = name;
+    scenario.frameCount = 600;
+    scenario.warmupFrames = 30;
+    scenario.dt = 1.0f / 60.0f;
+    scenario.syntheticBodies = 0;
+    scenario.scriptedCamera = true;
+
+    if (name == "default" || name == "blackhole") {
+        return true;
+    }
+    if (name == "tour") {
+        scenario.scriptedCamera = false;
+        return true;
+    }
+    if (name == "synthetic_10k") {
+        scenario.frameCount = 300;
+        scenario.syntheticBodies = 10000;
+        return true;
+    }
+    if (name == "synthetic_100k") {
+        scenario.frameCount = 120;
+        scenario.warmupFrames = 10;
+        scenario.syntheticBodies = 100000;
+        return true;
+    }
+    return false;
+}
+
+SolarSystem PerfScenario::buildSystem() const {
+    if (syntheticBodies <= 0) {
+        return SolarSystem::createDefault();
+    }
+
+    // A tenth of the bodies are planets, each with a moon; the rest fill the asteroid belt
+    SceneGenerator::Options options;
+    options.seed = 1;
+    options.planets = syntheticBodies / 10;
+    options.moonsPerBody = 1;
+    options.asteroids = syntheticBodies - 2 * options.planets;
+    options.ringedPlanets = options.planets / 100;
+    options.comets = syntheticBodies / 2000;
+    return SceneGenerator::generate(options);
+}
+
+uint64_t PerfScenario::keysHeld(int frame) const {
+    int measured = frame - warmupFrames;
+    if (name == "tour") {
+        // Enter planet selection at the start, then move to the next planet every second
+        if (frame == 0 || (measured >= 0 && measured % 60 == 0)) {
+            return keyBit(Key::Num3);
+        }
+    } else if (name == "blackhole") {
+        if (measured == 60) {
+            return keyBit(Key::X);
+        }
+    }
+    return 0;
+}
+
+FrameInput PerfScenario::input(int frame) const {
+    FrameInput frameInput;
+    frameInput.time = frame * dt;
+    frameInput.dt = dt;
+    frameInput.cursorX = 0.0;
+    frameInput.cursorY = 0.0;
+    frameInput.keys = keysHeld(frame);
+    frameInput.previousKeys = frame > 0 ? keysHeld(frame - 1) : 0;
+    return frameInput;
+}
+
+void PerfScenario::cameraPose(int frame, vec3& position, vec3& direction) const {
+    // One slow orbit around the star, bobbing above and below the orbital plane
+    float t = static_cast<float>(frame) / (warmupFrames + frameCount);
+    float angle = radians(360.0f * t);
+    float distance = syntheticBodies > 0 ? 90.0f : 70.0f;
+    position = systemCenter + vec3(distance * std::cos(angle), 12.0f * std::sin(2.0f * angle) + 6.0f,
+                                   distance * std::sin(angle));
+    direction = normalize(systemCenter - position);
+}
@@ -0,0 +1,58 @@
+#include "include/rendering/AtmosphereTable.hpp"
+#include "include/utils/GLDebug.hpp"
+#include "include/utils/GLState.hpp"
+#include <cmath>
+#include <cstdint>
+
+AtmosphereTable AtmosphereTable::create(const std::vector<Atmosphere>& atmospheres) {
+    AtmosphereTable table;
+    table.texture = 0;
+
+    // Bodies with the same atmosphere share a row; scenes only have a handful of distinct ones
+    std::vector<Atmosphere> distinct;
+    std::vector<int> bodyRows;
+    for (const Atmosphere& atmosphere : atmospheres) {
+        int row = -1;
+        if (atmosphere.isPresent()) {
+            for (size_t r = 0; r < distinct.size() && row < 0; ++r) {
+                if (distinct[r] == atmosphere) {
+                    row = static_cast<int>(r);
+                }
+            }
+            if (row < 0) {
+                row = static_cast<int>(distinct.size());
+                distinct.push_back(atmosphere);
+            }
+        }
+        bodyRows.push_back(row);
+    }
+
+    int height = static_cast<int>(distinct.size());
+    for (int row : bodyRows) {
+        table.rows.push_back(row < 0 ? -1.0f : (row + 0.5f) / height);
+    }
+    if (distinct.empty()) {
+        return table;
+    }
+
+    std::vector<uint8_t> texels;
+    texels.reserve(width * height * 4);
+    for (const Atmosphere& atmosphere : distinct) {
+        for (int i = 0; i < width; ++i) {
+            glm::vec4 scattering = atmosphere.scattering(static_cast<float>(i) / (width - 1));
+            for (int c = 0; c < 4; ++c) {
+                texels.push_back(static_cast<uint8_t>(std::lround(scattering[c] * 255.0f)));
+            }
+        }
+    }
+
+    glGenTextures(1, &table.texture);
+    GLState::bindTexture(GL_TEXTURE_2D, table.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    GLDebug::label(GL_TEXTURE, table.texture, "atmosphere table");
+    return table;
+}
@@ -0,0 +1,31 @@
+#include "include/rendering/BodyRenderer.hpp"
+#include "include/utils/TextureUtils.hpp"
+
+BodyRenderer BodyRenderer::create(const char* texturePath, const SphereLods& spheres) {
+    BodyRenderer renderer;
+    renderer.spheres = spheres;
+    renderer.texture = TextureUtils::loadTexture(texturePath);
+    return renderer;
+}
+
+void BodyRenderer::record(CommandBuffer& commands,
+                          const glm::mat4& worldMatrix,
+                          GLuint shader,
+                          float depth,
+                          int level,
+                          float atmosphereRow) const {
+    // Celestial bodies are drawn without culling to ensure correct appearance
+    DrawPacket packet;
+    packet.key = CommandBuffer::sortKey(RenderPass::Opaque, shader, texture, depth);
+    packet.program = shader;
+    packet.vao = spheres.vaos[level];
+    packet.texture = texture;
+    packet.mode = GL_TRIANGLES;
+    packet.count = spheres.indexCounts[level];
+    packet.indexed = true;
+    packet.cull = false;
+    packet.lit = true;
+    packet.atmosphereRow = atmosphereRow;
+    packet.worldMatrix = worldMatrix;
+    commands.add(packet);
+}
@@ -0,0 +1,168 @@
+#include "include/rendering/ClusteredLights.hpp"
+#include "include/utils/GLDebug.hpp"
+#include "include/utils/GLState.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace glm;
+
+namespace {
+const GLenum bufferFormats[3] = {GL_RGBA32F, GL_RG32UI, GL_R32UI};
+const char* bufferNames[3] = {"cluster lights", "cluster grid", "cluster light indices"};
+
+// Tile under a normalized device coordinate
+int tileOf(float ndc, int tiles) {
+    return std::clamp(static_cast<int>(std::floor((ndc * 0.5f + 0.5f) * tiles)), 0, tiles - 1);
+}
+
+// Replace a buffer's contents; texture buffers can't be empty, so there is always one element
+template <typename T>
+void upload(GLuint buffer, const std::vector<T>& data) {
+    glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+    size_t size = std::max<size_t>(data.size(), 1) * sizeof(T);
+    glBufferData(GL_TEXTURE_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    if (!data.empty()) {
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, data.size() * sizeof(T), data.data());
+    }
+}
+}
+
+ClusteredLights ClusteredLights::create(int width, int height, float nearPlane, float farPlane) {
+    ClusteredLights lights;
+    lights.resize(width, height);
+    lights.nearPlane = nearPlane;
+    lights.farPlane = farPlane;
+    float logRatio = std::log(farPlane / nearPlane);
+    lights.depthSlicing = vec2(slices / logRatio, -slices * std::log(nearPlane) / logRatio);
+    lights.lightCount = 0;
+    lights.clusterEntries = 0;
+    lights.grid.assign(clusterCount * 2, 0);
+
+    glGenBuffers(3, lights.buffers);
+    glGenTextures(3, lights.textures);
+    for (int i = 0; i < 3; ++i) {
+        glBindBuffer(GL_TEXTURE_BUFFER, lights.buffers[i]);
+        glBufferData(GL_TEXTURE_BUFFER, 16, nullptr, GL_STREAM_DRAW);
+        GLState::bindTexture(GL_TEXTURE_BUFFER, lights.textures[i]);
+        glTexBuffer(GL_TEXTURE_BUFFER, bufferFormats[i], lights.buffers[i]);
+        GLDebug::label(GL_BUFFER, lights.buffers[i], bufferNames[i]);
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    return lights;
+}
+
+void ClusteredLights::resize(int width, int height) {
+    tileSize = vec2(static_cast<float>(width) / tilesX, static_cast<float>(height) / tilesY);
+}
+
+int ClusteredLights::sliceOf(float depth) const {
+    int slice = static_cast<int>(std::floor(std::log(depth) * depthSlicing.x + depthSlicing.y));
+    return std::clamp(slice, 0, slices - 1);
+}
+
+bool ClusteredLights::clusterRange(const vec3& viewPosition, float radius, const mat4& projectionMatrix,
+                                   Range& range) const {
+    float depth = -viewPosition.z;
+    if (depth + radius < nearPlane || depth - radius > farPlane) {
+        return false;
+    }
+    range.z0 = sliceOf(std::max(depth - radius, nearPlane));
+    range.z1 = sliceOf(std::min(depth + radius, farPlane));
+
+    // A sphere reaching the near plane may cover any part of the screen
+    if (depth - radius <= nearPlane) {
+        range.x0 = 0;
+        range.x1 = tilesX - 1;
+        range.y0 = 0;
+        range.y1 = tilesY - 1;
+        return true;
+    }
+
+    // Screen bounds of the sphere's view-space bounding box; every corner is in front of the camera
+    vec2 low(1e30f);
+    vec2 high(-1e30f);
+    for (int corner = 0; corner < 8; ++corner) {
+        vec3 offset((corner & 1) ? radius : -radius, (corner & 2) ? radius : -radius, (corner & 4) ? radius : -radius);
+        vec4 clip = projectionMatrix * vec4(viewPosition + offset, 1.0f);
+        vec2 ndc = vec2(clip.x, clip.y) / clip.w;
+        low = min(low, ndc);
+        high = max(high, ndc);
+    }
+    if (high.x < -1.0f || low.x > 1.0f || high.y < -1.0f || low.y > 1.0f) {
+        return false;
+    }
+    range.x0 = tileOf(low.x, tilesX);
+    range.x1 = tileOf(high.x, tilesX);
+    range.y0 = tileOf(low.y, tilesY);
+    range.y1 = tileOf(high.y, tilesY);
+    return true;
+}
+
+void ClusteredLights::update(const std::vector<vec3>& positions,
+                             const std::vector<StarLight>& lights,
+                             const mat4& viewMatrix,
+                             const mat4& projectionMatrix) {
+    lightData.clear();
+    ranges.resize(lights.size());
+    std::fill(grid.begin(), grid.end(), 0);
+
+    // Count the lights reaching each cluster, capped, then lay the lists out one after another
+    for (size_t i = 0; i < lights.size(); ++i) {
+        lightData.push_back(vec4(positions[i], lights[i].range));
+        lightData.push_back(vec4(lights[i].color, 0.0f));
+
+        vec3 viewPosition = vec3(viewMatrix * vec4(positions[i], 1.0f));
+        Range& range = ranges[i];
+        range.visible = clusterRange(viewPosition, lights[i].range, projectionMatrix, range);
+        if (!range.visible) {
+            continue;
+        }
+        for (int z = range.z0; z <= range.z1; ++z) {
+            for (int y = range.y0; y <= range.y1; ++y) {
+                for (int x = range.x0; x <= range.x1; ++x) {
+                    uint32_t& count = grid[2 * ((z * tilesY + y) * tilesX + x) + 1];
+                    count = std::min<uint32_t>(count + 1, maxLightsPerCluster);
+                }
+            }
+        }
+    }
+    uint32_t offset = 0;
+    for (int cluster = 0; cluster < clusterCount; ++cluster) {
+        grid[2 * cluster] = offset;
+        offset += grid[2 * cluster + 1];
+    }
+
+    // Same order and cap as the count, so each list fills exactly
+    indices.assign(offset, 0);
+    filled.assign(clusterCount, 0);
+    for (size_t i = 0; i < lights.size(); ++i) {
+        const Range& range = ranges[i];
+        if (!range.visible) {
+            continue;
+        }
+        for (int z = range.z0; z <= range.z1; ++z) {
+            for (int y = range.y0; y <= range.y1; ++y) {
+                for (int x = range.x0; x <= range.x1; ++x) {
+                    int cluster = (z * tilesY + y) * tilesX + x;
+                    if (filled[cluster] < grid[2 * cluster + 1]) {
+                        indices[grid[2 * cluster] + filled[cluster]++] = static_cast<uint32_t>(i);
+                    }
+                }
+            }
+        }
+    }
+    lightCount = lights.size();
+    clusterEntries = indices.size();
+
+    upload(buffers[0], lightData);
+    upload(buffers[1], grid);
+    upload(buffers[2], indices);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void ClusteredLights::bind(GLenum firstUnit) const {
+    for (int i = 0; i < 3; ++i) {
+        GLState::activeTexture(firstUnit + i);
+        GLState::bindTexture(GL_TEXTURE_BUFFER, textures[i]);
+    }
+}
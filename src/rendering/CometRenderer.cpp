@@ -0,0 +1,91 @@
+#include "include/rendering/CometRenderer.hpp"
+#include "include/utils/GLState.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+CometRenderer CometRenderer::create(const char* texturePath, const SphereLods& spheres) {
+    CometRenderer renderer;
+    renderer.head = BodyRenderer::create(texturePath, spheres);
+    renderer.uploadedVersion = 0;
+    renderer.uploadedPoints = 0;
+
+    // Set up trail rendering
+    glGenVertexArrays(1, &renderer.trailVAO);
+    glGenBuffers(1, &renderer.trailVBO);
+
+    return renderer;
+}
+
+void CometRenderer::recordTrail(CommandBuffer& commands, GLuint shader, float depth, float fraction) const {
+    // Points are stored newest first, so a shorter strip keeps the part next to the head
+    unsigned int points = std::min(uploadedPoints, static_cast<unsigned int>(std::ceil(uploadedPoints * fraction)));
+    if (points < 2)
+        return;
+
+    // Trail points are in world space, drawn as a line strip
+    DrawPacket packet;
+    packet.key = CommandBuffer::sortKey(RenderPass::Transparent, shader, 0, depth);
+    packet.program = shader;
+    packet.vao = trailVAO;
+    packet.texture = 0;
+    packet.mode = GL_LINE_STRIP;
+    packet.count = points;
+    packet.indexed = false;
+    packet.cull = false;
+    packet.lit = false;
+    packet.atmosphereRow = 0.0f;
+    packet.worldMatrix = glm::mat4(1.0f);
+    commands.add(packet);
+}
+
+void CometRenderer::updateTrailVBO(const std::vector<TrailPoint>& trail, unsigned int trailVersion) {
+    if (trailVersion == uploadedVersion)
+        return;
+    uploadedVersion = trailVersion;
+    uploadedPoints = trail.size();
+    // A cleared trail (seek, restored history) draws nothing; the stale VBO is never read
+    if (trail.empty())
+        return;
+
+    std::vector<glm::vec3> vertices;
+    std::vector<glm::vec4> colors;
+
+    // Create line segments for the trail
+    for (size_t i = 0; i < trail.size(); ++i) {
+        vertices.push_back(trail[i].position);
+
+        // Color fades from bright blue/white to dark blue based on age
+        float fade = 1.0f - (trail[i].age / 10.0f); // Fade over 10 seconds
+        fade = std::max(0.0f, fade);
+
+        // Comet tail color - blue/white mix, fading out through alpha
+        glm::vec4 color = glm::vec4(0.7f + 0.3f * trail[i].brightness,
+                                    0.8f + 0.2f * trail[i].brightness,
+                                    1.0f,
+                                    fade);
+        colors.push_back(color);
+    }
+
+    GLState::bindVertexArray(trailVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, trailVBO);
+    glBufferData(GL_ARRAY_BUFFER,
+                 vertices.size() * sizeof(glm::vec3) + colors.size() * sizeof(glm::vec4),
+                 nullptr,
+                 GL_DYNAMIC_DRAW);
+
+    // Upload vertices
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(glm::vec3), &vertices[0]);
+
+    // Upload colors
+    glBufferSubData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), 
+                   colors.size() * sizeof(glm::vec4), &colors[0]);
+
+    // Set up vertex attributes
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 0, 
+                         (void*)(vertices.size() * sizeof(glm::vec3)));
+    glEnableVertexAttribArray(1);
+}
@@ -0,0 +1,16 @@
+#include "include/rendering/CommandBuffer.hpp"
+#include <cstring>
+
+uint64_t CommandBuffer::sortKey(RenderPass pass, GLuint program, GLuint texture, float depth) {
+    // Non-negative floats order the same as their bit patterns
+    if (!(depth > 0.0f)) {
+        depth = 0.0f;
+    }
+    uint32_t depthBits;
+    std::memcpy(&depthBits, &depth, sizeof(depthBits));
+
+    uint64_t passBits = static_cast<uint64_t>(pass) << 60;
+    uint64_t programBits = static_cast<uint64_t>(program & 0xfffu);
+    uint64_t textureBits = static_cast<uint64_t>(texture & 0xffffu);
+    return passBits | programBits << 48 | textureBits << 32 | depthBits;
+}
@@ -0,0 +1,82 @@
+#include "include/rendering/DynamicResolution.hpp"
+#include "include/utils/GpuProfiler.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Frame time aimed for when rescaling, below the target so small spikes don't go over it
+constexpr float headroom = 0.9f;
+// Only scale back up once frames are this far under the target
+constexpr float upscaleBelow = 0.75f;
+// Largest change per step; down quickly when over budget, up cautiously
+constexpr float maxStepDown = 0.75f;
+constexpr float maxStepUp = 1.1f;
+// Weight of a new sample in averageMs
+constexpr float smoothing = 0.2f;
+
+// Scaled width in multiples of 8 pixels, so small scale changes don't resize every frame
+int scaledWidth(int width, float scale) {
+    if (scale >= DynamicResolution::maxScale) {
+        return width;
+    }
+    int scaled = static_cast<int>(std::lround(width * scale / 8.0f)) * 8;
+    return std::clamp(scaled, 8, width);
+}
+}
+
+DynamicResolution DynamicResolution::create(int width, int height, float targetMs) {
+    DynamicResolution resolution;
+    resolution.targetMs = targetMs;
+    resolution.averageMs = 0.0f;
+    resolution.fullWidth = width;
+    resolution.fullHeight = height;
+    resolution.settleFrames = 0;
+    resolution.scaleLimit = maxScale;
+    resolution.applyScale(maxScale);
+    return resolution;
+}
+
+void DynamicResolution::applyScale(float newScale) {
+    scale = newScale;
+    // Height follows the rounded width, keeping the aspect ratio of the projection
+    renderWidth = scaledWidth(fullWidth, scale);
+    double aspect = static_cast<double>(fullHeight) / fullWidth;
+    renderHeight = std::max(1, static_cast<int>(std::lround(renderWidth * aspect)));
+}
+
+bool DynamicResolution::update(float gpuFrameMs) {
+    if (targetMs <= 0.0f || gpuFrameMs <= 0.0f) {
+        return false;
+    }
+    // Samples still in flight were rendered at the previous size
+    if (settleFrames > 0) {
+        settleFrames--;
+        return false;
+    }
+    averageMs = averageMs > 0.0f ? averageMs + (gpuFrameMs - averageMs) * smoothing : gpuFrameMs;
+
+    bool over = averageMs > targetMs;
+    bool under = averageMs < targetMs * upscaleBelow && scale < scaleLimit;
+    if (!over && !under) {
+        return false;
+    }
+    float step = std::clamp(std::sqrt(targetMs * headroom / averageMs), maxStepDown, maxStepUp);
+    return resize(std::clamp(scale * step, minScale, scaleLimit));
+}
+
+bool DynamicResolution::setScaleLimit(float limit) {
+    scaleLimit = std::clamp(limit, minScale, maxScale);
+    return scale > scaleLimit && resize(scaleLimit);
+}
+
+bool DynamicResolution::resize(float newScale) {
+    int oldWidth = renderWidth;
+    int oldHeight = renderHeight;
+    applyScale(newScale);
+    if (renderWidth == oldWidth && renderHeight == oldHeight) {
+        return false;
+    }
+    settleFrames = GpuProfiler::framesInFlight + 1;
+    averageMs = 0.0f;
+    return true;
+}
@@ -0,0 +1,120 @@
+#include "include/rendering/QualityGovernor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+// Move value by step towards target, without passing it
+float stepTowards(float value, float target, float step) {
+    return value < target ? std::min(value + step, target) : std::max(value - step, target);
+}
+
+void logChange(const std::string& name, float from, float to, float percentileMs, float budgetMs) {
+    std::cout << "Quality: " << name << " " << from << " -> " << to << " (90th percentile " << percentileMs
+              << " ms, budget " << budgetMs << " ms)" << std::endl;
+}
+}
+
+QualityGovernor::QualityGovernor(float budget)
+    : budgetMs(budget), raiseWait(1), windowsUnder(0), lastRaised(-1) {
+    samples.reserve(windowFrames);
+}
+
+void QualityGovernor::addKnob(const std::string& name, float& value, float best, float worst, float step) {
+    value = best;
+    knobs.push_back(Knob{name, &value, best, worst, std::abs(step)});
+}
+
+bool QualityGovernor::setBounds(const std::string& name, float best, float worst) {
+    for (Knob& knob : knobs) {
+        if (knob.name == name) {
+            knob.best = best;
+            knob.worst = worst;
+            *knob.value = std::clamp(*knob.value, std::min(best, worst), std::max(best, worst));
+            return true;
+        }
+    }
+    return false;
+}
+
+bool QualityGovernor::atWorst(const Knob& knob) {
+    return *knob.value == knob.worst;
+}
+
+bool QualityGovernor::atBest(const Knob& knob) {
+    return *knob.value == knob.best;
+}
+
+bool QualityGovernor::addSample(float frameMs) {
+    if (budgetMs <= 0.0f || knobs.empty()) {
+        return false;
+    }
+    samples.push_back(frameMs);
+    if (samples.size() < static_cast<size_t>(windowFrames)) {
+        return false;
+    }
+
+    // 90th percentile, so a few slow frames count but a single hitch doesn't
+    size_t rank = samples.size() * 9 / 10;
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    float percentileMs = samples[rank];
+    samples.clear();
+
+    // The last raise held for a whole window; let the next one come sooner again
+    if (percentileMs <= budgetMs && lastRaised >= 0) {
+        raiseWait = std::max(raiseWait / 2, 1);
+        lastRaised = -1;
+    }
+
+    if (percentileMs > budgetMs) {
+        windowsUnder = 0;
+        return lower(percentileMs);
+    }
+    if (percentileMs < budgetMs * raiseBelow) {
+        windowsUnder++;
+        if (windowsUnder >= raiseWait) {
+            windowsUnder = 0;
+            return raise(percentileMs);
+        }
+        return false;
+    }
+    // Within the band: keep what we have
+    windowsUnder = 0;
+    return false;
+}
+
+bool QualityGovernor::lower(float percentileMs) {
+    for (size_t i = 0; i < knobs.size(); ++i) {
+        Knob& knob = knobs[i];
+        if (atWorst(knob)) {
+            continue;
+        }
+        // Lowering what was just raised means the raise was premature; wait longer next time
+        if (static_cast<int>(i) == lastRaised) {
+            raiseWait = std::min(raiseWait * 2, maxRaiseWait);
+        }
+        lastRaised = -1;
+
+        float from = *knob.value;
+        *knob.value = stepTowards(from, knob.worst, knob.step);
+        logChange(knob.name, from, *knob.value, percentileMs, budgetMs);
+        return true;
+    }
+    return false;
+}
+
+bool QualityGovernor::raise(float percentileMs) {
+    for (size_t i = knobs.size(); i-- > 0;) {
+        Knob& knob = knobs[i];
+        if (atBest(knob)) {
+            continue;
+        }
+        lastRaised = static_cast<int>(i);
+
+        float from = *knob.value;
+        *knob.value = stepTowards(from, knob.best, knob.step);
+        logChange(knob.name, from, *knob.value, percentileMs, budgetMs);
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,182 @@
+#include "include/rendering/RenderQueue.hpp"
+#include "include/rendering/ClusteredLights.hpp"
+#include "include/rendering/TransparencyPass.hpp"
+#include "include/utils/GLState.hpp"
+#include <algorithm>
+
+namespace {
+const GLuint unbound = ~0u;   // No program looked up yet
+
+RenderPass passOf(uint64_t key) {
+    return static_cast<RenderPass>(key >> 60);
+}
+
+const char* passName(RenderPass pass) {
+    return pass == RenderPass::Transparent ? "Transparent" : "Opaque";
+}
+}
+
+RenderQueue::RenderQueue() : submittedPackets(0) {}
+
+void RenderQueue::add(const CommandBuffer& buffer) {
+    buffers.push_back(&buffer);
+}
+
+RenderQueue::ProgramUniforms& RenderQueue::uniformsFor(GLuint program) {
+    for (ProgramUniforms& uniforms : programs) {
+        if (uniforms.program == program) {
+            return uniforms;
+        }
+    }
+    ProgramUniforms uniforms;
+    uniforms.program = program;
+    uniforms.worldMatrix = glGetUniformLocation(program, "worldMatrix");
+    uniforms.viewMatrix = glGetUniformLocation(program, "viewMatrix");
+    uniforms.projectionMatrix = glGetUniformLocation(program, "projectionMatrix");
+    uniforms.texture1 = glGetUniformLocation(program, "texture1");
+    uniforms.lights = glGetUniformLocation(program, "lights");
+    uniforms.clusterGrid = glGetUniformLocation(program, "clusterGrid");
+    uniforms.clusterLights = glGetUniformLocation(program, "clusterLights");
+    uniforms.clusterCounts = glGetUniformLocation(program, "clusterCounts");
+    uniforms.clusterTileSize = glGetUniformLocation(program, "clusterTileSize");
+    uniforms.clusterDepthSlicing = glGetUniformLocation(program, "clusterDepthSlicing");
+    uniforms.viewPos = glGetUniformLocation(program, "viewPos");
+    uniforms.planetPositions = glGetUniformLocation(program, "planetPositions");
+    uniforms.planetRadii = glGetUniformLocation(program, "planetRadii");
+    uniforms.numPlanets = glGetUniformLocation(program, "numPlanets");
+    uniforms.atmosphereTable = glGetUniformLocation(program, "atmosphereTable");
+    uniforms.atmosphereRow = glGetUniformLocation(program, "atmosphereRow");
+    programs.push_back(uniforms);
+    return programs.back();
+}
+
+void RenderQueue::submit(const FrameUniforms& frame, GpuProfiler& gpuProfiler, const TransparencyPass& transparency) {
+    entries.clear();
+    for (size_t b = 0; b < buffers.size(); ++b) {
+        const std::vector<DrawPacket>& packets = buffers[b]->items();
+        for (size_t i = 0; i < packets.size(); ++i) {
+            entries.push_back(SortEntry{packets[i].key, static_cast<uint32_t>(b), static_cast<uint32_t>(i)});
+        }
+    }
+    // Ties keep recording order, so equal keys draw the same way every frame
+    std::sort(entries.begin(), entries.end(), [](const SortEntry& a, const SortEntry& b) {
+        if (a.key != b.key) {
+            return a.key < b.key;
+        }
+        return a.buffer != b.buffer ? a.buffer < b.buffer : a.index < b.index;
+    });
+
+    for (ProgramUniforms& uniforms : programs) {
+        uniforms.atmosphereRowValue = -1.0f;
+        uniforms.frameSet = false;
+        uniforms.litSet = false;
+    }
+
+    GLuint program = unbound;
+    ProgramUniforms* uniforms = nullptr;
+    const char* openPass = nullptr;
+    bool transparent = false;
+    Profiler& profiler = Profiler::instance();
+
+    if (!entries.empty()) {
+        if (frame.atmosphereTable) {
+            GLState::activeTexture(GL_TEXTURE1);
+            GLState::bindTexture(GL_TEXTURE_2D, frame.atmosphereTable);
+        }
+        frame.lights->bind(GL_TEXTURE2);
+        GLState::activeTexture(GL_TEXTURE0);
+    }
+    for (const SortEntry& entry : entries) {
+        const DrawPacket& packet = buffers[entry.buffer]->items()[entry.index];
+
+        const char* pass = passName(passOf(packet.key));
+        if (pass != openPass) {
+            if (openPass) {
+                gpuProfiler.endPass();
+                profiler.endScope();
+            }
+            profiler.beginScope(pass);
+            gpuProfiler.beginPass(pass);
+            openPass = pass;
+
+            // Translucent packets come last; blending is set up once for all of them
+            if (passOf(packet.key) == RenderPass::Transparent) {
+                transparent = transparency.beginTransparent();
+                if (!transparent) {
+                    break;
+                }
+            } else {
+                GLState::disable(GL_BLEND);
+            }
+        }
+
+        if (packet.program != program) {
+            program = packet.program;
+            GLState::useProgram(program);
+            uniforms = &uniformsFor(program);
+            if (!uniforms->frameSet) {
+                glUniformMatrix4fv(uniforms->viewMatrix, 1, GL_FALSE, &frame.viewMatrix[0][0]);
+                glUniformMatrix4fv(uniforms->projectionMatrix, 1, GL_FALSE, &frame.projectionMatrix[0][0]);
+                glUniform1i(uniforms->texture1, 0);
+                glUniform1i(uniforms->atmosphereTable, 1);
+                uniforms->frameSet = true;
+            }
+        }
+        // Permutations without shadows (or lighting) have no such uniforms; their locations are -1
+        if (packet.lit && !uniforms->litSet) {
+            const ClusteredLights& lights = *frame.lights;
+            glUniform1i(uniforms->lights, 2);
+            glUniform1i(uniforms->clusterGrid, 3);
+            glUniform1i(uniforms->clusterLights, 4);
+            glUniform3i(uniforms->clusterCounts, ClusteredLights::tilesX, ClusteredLights::tilesY,
+                        ClusteredLights::slices);
+            glUniform2fv(uniforms->clusterTileSize, 1, &lights.tileSize[0]);
+            glUniform2fv(uniforms->clusterDepthSlicing, 1, &lights.depthSlicing[0]);
+            glUniform3fv(uniforms->viewPos, 1, &frame.viewPos[0]);
+            GLsizei casters = static_cast<GLsizei>(frame.shadowCasters);
+            if (casters > 0) {
+                glUniform3fv(uniforms->planetPositions, casters, &(*frame.shadowPositions)[0][0]);
+                glUniform1fv(uniforms->planetRadii, casters, frame.shadowRadii->data());
+            }
+            glUniform1i(uniforms->numPlanets, casters);
+            uniforms->litSet = true;
+        }
+        if (uniforms->atmosphereRow >= 0 && uniforms->atmosphereRowValue != packet.atmosphereRow) {
+            uniforms->atmosphereRowValue = packet.atmosphereRow;
+            glUniform1f(uniforms->atmosphereRow, packet.atmosphereRow);
+        }
+        glUniformMatrix4fv(uniforms->worldMatrix, 1, GL_FALSE, &packet.worldMatrix[0][0]);
+
+        // GLState skips whatever the previous packet already set
+        if (packet.cull) {
+            GLState::enable(GL_CULL_FACE);
+        } else {
+            GLState::disable(GL_CULL_FACE);
+        }
+        if (packet.texture != 0) {
+            GLState::bindTexture(GL_TEXTURE_2D, packet.texture);
+        }
+        GLState::bindVertexArray(packet.vao);
+
+        if (packet.indexed) {
+            GLState::drawElements(packet.mode, packet.count, GL_UNSIGNED_INT, 0);
+        } else {
+            GLState::drawArrays(packet.mode, 0, packet.count);
+        }
+    }
+    if (transparent) {
+        transparency.composite();
+    }
+    if (openPass) {
+        gpuProfiler.endPass();
+        profiler.endScope();
+    }
+
+    // Leave the defaults the rest of the frame draws with
+    GLState::enable(GL_CULL_FACE);
+    GLState::disable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    submittedPackets = entries.size();
+    buffers.clear();
+}
@@ -0,0 +1,35 @@
+#include "include/rendering/RingRenderer.hpp"
+#include "include/rendering/SphereBuffers.hpp"
+#include "include/utils/TextureUtils.hpp"
+#include <vector>
+
+using namespace glm;
+
+RingRenderer RingRenderer::create(const PlanetRing& ring, const char* texturePath) {
+    std::vector<vec3> vertices;
+    std::vector<vec2> uvs;
+    std::vector<unsigned int> indices;
+    ring.generateGeometry(vertices, uvs, indices);
+
+    RingRenderer renderer;
+    renderer.vao = SphereBuffers::setupSphereBuffers(vertices, uvs, indices);
+    renderer.indexCount = indices.size();
+    renderer.texture = TextureUtils::loadTexture(texturePath);
+    return renderer;
+}
+
+void RingRenderer::record(CommandBuffer& commands, const mat4& worldMatrix, GLuint shader, float depth) const {
+    DrawPacket packet;
+    packet.key = CommandBuffer::sortKey(RenderPass::Transparent, shader, texture, depth);
+    packet.program = shader;
+    packet.vao = vao;
+    packet.texture = texture;
+    packet.mode = GL_TRIANGLES;
+    packet.count = indexCount;
+    packet.indexed = true;
+    packet.cull = false;
+    packet.lit = true;
+    packet.atmosphereRow = 0.0f;
+    packet.worldMatrix = worldMatrix;
+    commands.add(packet);
+}
@@ -0,0 +1,114 @@
+#include "include/rendering/SceneRenderer.hpp"
+#include <algorithm>
+#include <string>
+#include <thread>
+
+namespace {
+// Sphere level for a unit sphere scaled by worldMatrix at the given distance
+int sphereLevel(const glm::mat4& worldMatrix, float depth, float pixelScale, float bias) {
+    float radius = glm::length(glm::vec3(worldMatrix[0]));
+    return SphereLods::levelFor(radius * pixelScale / std::max(depth, 1e-6f), bias);
+}
+}
+
+SceneRenderer SceneRenderer::create(const SolarSystem& solarSystem, float pixelScale) {
+    SceneRenderer renderer;
+    renderer.spheres = SphereLods::create();
+    renderer.pixelScale = pixelScale;
+
+    std::vector<std::string> loadedPaths;
+    for (const std::string& texturePath : solarSystem.texturePaths) {
+        int index = -1;
+        for (size_t i = 0; i < loadedPaths.size(); ++i) {
+            if (loadedPaths[i] == texturePath) {
+                index = static_cast<int>(i);
+                break;
+            }
+        }
+        if (index < 0) {
+            index = static_cast<int>(renderer.bodyRenderers.size());
+            renderer.bodyRenderers.push_back(BodyRenderer::create(texturePath.c_str(), renderer.spheres));
+            loadedPaths.push_back(texturePath);
+        }
+        renderer.bodyRendererIndex.push_back(index);
+    }
+
+    for (const std::string& texturePath : solarSystem.cometTexturePaths) {
+        renderer.cometRenderers.push_back(CometRenderer::create(texturePath.c_str(), renderer.spheres));
+    }
+    for (size_t i = 0; i < solarSystem.rings.size(); ++i) {
+        renderer.ringRenderers.push_back(
+            RingRenderer::create(solarSystem.rings[i], solarSystem.ringTexturePaths[i].c_str()));
+    }
+    renderer.emissive = solarSystem.emissive;
+    renderer.ringPlanets = solarSystem.ringPlanets;
+    renderer.atmospheres = AtmosphereTable::create(solarSystem.atmospheres);
+    return renderer;
+}
+
+void SceneRenderer::record(const SceneSnapshot& snapshot,
+                           const ShaderPrograms& shaders,
+                           const QualitySettings& quality,
+                           RenderQueue& queue) {
+    const std::vector<int>& visible = snapshot.visibleBodies;
+    // Comparison mode has no shadow casters, so bodies skip the shadow test entirely
+    bool shadows = quality.shadowCasterCount(snapshot.shadowPositions.size()) > 0;
+    GLuint sunShader = shaders.sphereProgram(SphereVariant::Sun);
+    GLuint planetShader = shaders.sphereProgram(shadows ? SphereVariant::PlanetShadowed : SphereVariant::Planet);
+    GLuint airlessShader = shaders.sphereProgram(shadows ? SphereVariant::AirlessShadowed : SphereVariant::Airless);
+    GLuint ringShader = shaders.sphereProgram(SphereVariant::Ring);
+    GLuint trailShader = shaders.trail;
+
+    size_t workerCount = 1;
+    if (visible.size() >= parallelRecordBodies) {
+        if (!workers) {
+            workers = std::make_unique<WorkerPool>(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+        }
+        workerCount = std::clamp<size_t>(workers->size(), 1, visible.size() / parallelRecordBodies + 1);
+    }
+    bodyCommands.resize(workerCount);
+
+    auto recordBodies = [&](size_t worker) {
+        CommandBuffer& commands = bodyCommands[worker];
+        commands.clear();
+        size_t end = visible.size() * (worker + 1) / workerCount;
+        for (size_t n = visible.size() * worker / workerCount; n < end; ++n) {
+            int i = visible[n];
+            const glm::mat4& worldMatrix = snapshot.bodyMatrices[i];
+            float depth = glm::distance(glm::vec3(worldMatrix[3]), snapshot.cameraPosition);
+            float atmosphereRow = atmospheres.rows[i];
+            GLuint shader = emissive[i] ? sunShader : atmosphereRow >= 0.0f ? planetShader : airlessShader;
+            int level = sphereLevel(worldMatrix, depth, pixelScale, quality.sphereLodBias);
+            bodyRenderers[bodyRendererIndex[i]].record(commands, worldMatrix, shader, depth, level, atmosphereRow);
+        }
+    };
+    if (workerCount > 1) {
+        workers->run(workerCount, recordBodies);
+    } else {
+        recordBodies(0);
+    }
+
+    // Rings of visible planets, then comet trails and heads
+    ringCometCommands.clear();
+    for (size_t r = 0; r < ringRenderers.size(); ++r) {
+        if (!std::binary_search(visible.begin(), visible.end(), ringPlanets[r])) {
+            continue;
+        }
+        const glm::mat4& worldMatrix = snapshot.ringMatrices[r];
+        float depth = glm::distance(glm::vec3(worldMatrix[3]), snapshot.cameraPosition);
+        ringRenderers[r].record(ringCometCommands, worldMatrix, ringShader, depth);
+    }
+    for (size_t i = 0; i < snapshot.comets.size(); ++i) {
+        const SceneSnapshot::CometView& comet = snapshot.comets[i];
+        float depth = glm::distance(glm::vec3(comet.headMatrix[3]), snapshot.cameraPosition);
+        cometRenderers[i].updateTrailVBO(comet.trail, comet.trailVersion);
+        cometRenderers[i].recordTrail(ringCometCommands, trailShader, depth, quality.trailFraction);
+        int level = sphereLevel(comet.headMatrix, depth, pixelScale, quality.sphereLodBias);
+        cometRenderers[i].head.record(ringCometCommands, comet.headMatrix, airlessShader, depth, level);
+    }
+
+    for (const CommandBuffer& commands : bodyCommands) {
+        queue.add(commands);
+    }
+    queue.add(ringCometCommands);
+}
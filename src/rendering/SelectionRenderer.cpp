@@ -0,0 +1,40 @@
+#include "include/rendering/SelectionRenderer.hpp"
+#include "include/rendering/SphereBuffers.hpp"
+#include "include/utils/GLState.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace glm;
+
+SelectionRenderer SelectionRenderer::create() {
+    SelectionRenderer renderer;
+    renderer.vao = SphereBuffers::createTexturedSphereVAO(40, 40, renderer.indexCount);
+    return renderer;
+}
+
+void SelectionRenderer::render(const CelestialBody& selectedBody,
+                               GLuint shader,
+                               const mat4& viewMatrix,
+                               const mat4& projectionMatrix) const {
+    GLState::useProgram(shader);
+    GLState::polygonMode(GL_FRONT_AND_BACK, GL_LINE); // Wireframe mode
+    GLState::lineWidth(3.0f);                         // Thick lines
+
+    // Create a slightly larger sphere around the selected planet
+    float indicatorScale = selectedBody.scale.x * 1.5f;
+    mat4 worldMatrix = translate(mat4(1.0f), selectedBody.position) * scale(mat4(1.0f), vec3(indicatorScale));
+
+    glUniformMatrix4fv(glGetUniformLocation(shader, "worldMatrix"), 1, GL_FALSE, &worldMatrix[0][0]);
+    glUniformMatrix4fv(glGetUniformLocation(shader, "viewMatrix"), 1, GL_FALSE, &viewMatrix[0][0]);
+    glUniformMatrix4fv(glGetUniformLocation(shader, "projectionMatrix"), 1, GL_FALSE, &projectionMatrix[0][0]);
+
+    // Set white color for the selection indicator
+    vec3 selectionColor = vec3(1.0f, 1.0f, 1.0f); // White
+    glUniform3fv(glGetUniformLocation(shader, "selectionColor"), 1, &selectionColor[0]);
+
+    // Render the wireframe sphere
+    GLState::bindVertexArray(vao);
+    GLState::drawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
+
+    GLState::polygonMode(GL_FRONT_AND_BACK, GL_FILL); // Back to solid mode
+    GLState::lineWidth(1.0f);                         // Reset line width
+}
@@ -0,0 +1,24 @@
+#include "include/rendering/SphereLods.hpp"
+#include "include/rendering/SphereBuffers.hpp"
+#include "include/utils/GLDebug.hpp"
+#include <cmath>
+#include <string>
+
+SphereLods SphereLods::create() {
+    SphereLods lods;
+    for (int level = 0; level < levels; ++level) {
+        lods.vaos[level] =
+            SphereBuffers::createTexturedSphereVAO(segments[level], segments[level], lods.indexCounts[level]);
+        GLDebug::label(GL_VERTEX_ARRAY, lods.vaos[level], ("sphere lod " + std::to_string(level)).c_str());
+    }
+    return lods;
+}
+
+int SphereLods::levelFor(float pixelRadius, float bias) {
+    float radius = pixelRadius * std::exp2(-bias);
+    int level = 0;
+    while (level < levels - 1 && radius < minPixelRadius[level]) {
+        level++;
+    }
+    return level;
+}
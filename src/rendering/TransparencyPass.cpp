@@ -0,0 +1,138 @@
+#include "include/rendering/TransparencyPass.hpp"
+#include "include/utils/GLDebug.hpp"
+#include "include/utils/GLState.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+GLuint createTarget(GLenum internalFormat, GLenum format, int width, int height) {
+    GLuint texture;
+    glGenTextures(1, &texture);
+    GLState::bindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    return texture;
+}
+
+bool framebufferComplete(const char* name) {
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "ERROR::FRAMEBUFFER::" << name << "::INCOMPLETE (0x" << std::hex << status << std::dec
+                  << "), translucent surfaces won't be drawn" << std::endl;
+        return false;
+    }
+    return true;
+}
+}
+
+TransparencyPass TransparencyPass::create(int width, int height, GLuint compositeShader) {
+    TransparencyPass pass;
+    pass.width = width;
+    pass.height = height;
+    pass.renderWidth = width;
+    pass.renderHeight = height;
+    pass.compositeShader = compositeShader;
+
+    pass.sceneColor = createTarget(GL_RGBA8, GL_RGBA, width, height);
+    pass.accumulation = createTarget(GL_RGBA16F, GL_RGBA, width, height);
+    pass.weight = createTarget(GL_R16F, GL_RED, width, height);
+    GLDebug::label(GL_TEXTURE, pass.sceneColor, "scene color");
+    GLDebug::label(GL_TEXTURE, pass.accumulation, "oit accumulation");
+    GLDebug::label(GL_TEXTURE, pass.weight, "oit weight");
+
+    glGenRenderbuffers(1, &pass.depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, pass.depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+
+    glGenFramebuffers(1, &pass.sceneFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, pass.sceneFramebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, pass.sceneColor, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, pass.depthBuffer);
+    pass.complete = framebufferComplete("SCENE");
+
+    glGenFramebuffers(1, &pass.transparentFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, pass.transparentFramebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, pass.accumulation, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, pass.weight, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, pass.depthBuffer);
+    const GLenum drawBuffers[] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+    glDrawBuffers(2, drawBuffers);
+    pass.complete = framebufferComplete("TRANSPARENT") && pass.complete;
+    GLDebug::label(GL_FRAMEBUFFER, pass.sceneFramebuffer, "scene");
+    GLDebug::label(GL_FRAMEBUFFER, pass.transparentFramebuffer, "oit transparent");
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glGenVertexArrays(1, &pass.emptyVAO);
+    return pass;
+}
+
+void TransparencyPass::setRenderSize(int newWidth, int newHeight) {
+    if (complete) {
+        renderWidth = std::clamp(newWidth, 1, width);
+        renderHeight = std::clamp(newHeight, 1, height);
+    }
+}
+
+void TransparencyPass::beginScene() const {
+    if (complete) {
+        glBindFramebuffer(GL_FRAMEBUFFER, sceneFramebuffer);
+    }
+    // Clears cover the whole target, draws only this part; the composite reads texels by
+    // fragment position, so it lines up
+    glViewport(0, 0, renderWidth, renderHeight);
+}
+
+bool TransparencyPass::beginTransparent() const {
+    // The OIT shaders only make sense with both targets
+    if (!complete) {
+        return false;
+    }
+    GLState::enable(GL_BLEND);
+    GLState::enable(GL_DEPTH_TEST);
+    GLState::depthMask(GL_FALSE);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, transparentFramebuffer);
+    const GLfloat clearAccumulation[] = {0.0f, 0.0f, 0.0f, 1.0f};
+    const GLfloat clearWeight[] = {0.0f, 0.0f, 0.0f, 0.0f};
+    glClearBufferfv(GL_COLOR, 0, clearAccumulation);
+    glClearBufferfv(GL_COLOR, 1, clearWeight);
+
+    // Color and weight add up; the accumulation target's alpha multiplies by (1 - alpha)
+    GLState::blendFuncSeparate(GL_ONE, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
+    return true;
+}
+
+void TransparencyPass::composite() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, sceneFramebuffer);
+
+    // result = average * (1 - revealage) + scene * revealage, the shader outputs revealage as alpha
+    GLState::blendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA);
+    GLState::disable(GL_DEPTH_TEST);
+    GLState::useProgram(compositeShader);
+    GLState::activeTexture(GL_TEXTURE1);
+    GLState::bindTexture(GL_TEXTURE_2D, weight);
+    GLState::activeTexture(GL_TEXTURE0);
+    GLState::bindTexture(GL_TEXTURE_2D, accumulation);
+    GLState::bindVertexArray(emptyVAO);
+    GLState::drawArrays(GL_TRIANGLES, 0, 3);
+    GLState::enable(GL_DEPTH_TEST);
+    GLState::depthMask(GL_TRUE);
+    GLState::disable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void TransparencyPass::present() const {
+    if (!complete) {
+        return;
+    }
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, sceneFramebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    bool scaled = renderWidth != width || renderHeight != height;
+    glBlitFramebuffer(0, 0, renderWidth, renderHeight, 0, 0, width, height, GL_COLOR_BUFFER_BIT,
+                      scaled ? GL_LINEAR : GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, width, height);
+}
@@ -0,0 +1,181 @@
+#include "include/simulation/Ephemeris.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+const char magic[4] = {'S', 'S', 'E', 'P'};
+const size_t headerSize = 32;
+const size_t bodyRecordSize = 48;
+
+// The mapping gives no alignment guarantee, so values are copied out
+template <typename T> T readValue(const unsigned char* bytes, size_t offset) {
+    T value;
+    std::memcpy(&value, bytes + offset, sizeof(T));
+    return value;
+}
+
+template <typename T> void writeValue(std::ofstream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+}
+
+bool Ephemeris::open(const std::string& path) {
+    bodies.clear();
+    if (!file.open(path)) {
+        return false;
+    }
+    const unsigned char* bytes = file.data();
+    if (file.size() < headerSize || std::memcmp(bytes, magic, 4) != 0 || readValue<uint32_t>(bytes, 4) != version) {
+        std::cerr << "Not a SolarScope ephemeris (or wrong version): " << path << std::endl;
+        file.close();
+        return false;
+    }
+
+    uint32_t bodyCount = readValue<uint32_t>(bytes, 8);
+    start = readValue<double>(bytes, 16);
+    end = readValue<double>(bytes, 24);
+    if (file.size() < headerSize + static_cast<size_t>(bodyCount) * bodyRecordSize) {
+        std::cerr << "Truncated ephemeris body table: " << path << std::endl;
+        file.close();
+        return false;
+    }
+
+    for (uint32_t i = 0; i < bodyCount; ++i) {
+        size_t record = headerSize + i * bodyRecordSize;
+        char name[17] = {};
+        std::memcpy(name, bytes + record, 16);
+
+        Body body;
+        body.name = name;
+        body.center = readValue<int32_t>(bytes, record + 16);
+        body.coefficientCount = readValue<uint32_t>(bytes, record + 20);
+        body.granuleDays = readValue<double>(bytes, record + 24);
+        body.granuleCount = readValue<uint32_t>(bytes, record + 32);
+        body.offset = readValue<uint64_t>(bytes, record + 40);
+
+        uint64_t dataSize = uint64_t(body.granuleCount) * 3 * body.coefficientCount * sizeof(double);
+        if (body.coefficientCount == 0 || body.coefficientCount > maxCoefficients || body.granuleCount == 0 ||
+            body.granuleDays <= 0.0 || body.center >= static_cast<int>(bodyCount) ||
+            body.offset + dataSize > file.size()) {
+            std::cerr << "Invalid ephemeris record for '" << body.name << "': " << path << std::endl;
+            file.close();
+            bodies.clear();
+            return false;
+        }
+        bodies.push_back(body);
+    }
+    return true;
+}
+
+int Ephemeris::findBody(const std::string& name) const {
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        if (bodies[i].name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+glm::dvec3 Ephemeris::position(int index, double julianDate) const {
+    const Body& body = bodies[index];
+    double days = std::min(std::max(julianDate, start), end) - start;
+    uint32_t granule = std::min(static_cast<uint32_t>(days / body.granuleDays), body.granuleCount - 1);
+
+    // Normalized time within the granule, [-1, 1]
+    double tau = 2.0 * (days - granule * body.granuleDays) / body.granuleDays - 1.0;
+    double twoTau = 2.0 * tau;
+
+    const unsigned int count = body.coefficientCount;
+    double coefficients[3 * maxCoefficients];
+    std::memcpy(coefficients,
+                file.data() + body.offset + uint64_t(granule) * 3 * count * sizeof(double),
+                3 * count * sizeof(double));
+
+    // Clenshaw recurrence, the three axes in lockstep so the lanes vectorize
+    double b1[3] = {0.0, 0.0, 0.0};
+    double b2[3] = {0.0, 0.0, 0.0};
+    for (int k = static_cast<int>(count) - 1; k >= 1; --k) {
+        for (int axis = 0; axis < 3; ++axis) {
+            double b0 = twoTau * b1[axis] - b2[axis] + coefficients[axis * count + k];
+            b2[axis] = b1[axis];
+            b1[axis] = b0;
+        }
+    }
+    double result[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        result[axis] = tau * b1[axis] - b2[axis] + coefficients[axis * count];
+    }
+    return glm::dvec3(result[0], result[1], result[2]);
+}
+
+bool Ephemeris::write(const std::string& path, double startJd, double endJd, const std::vector<BodyTable>& tables) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "Failed to write ephemeris: " << path << std::endl;
+        return false;
+    }
+
+    out.write(magic, 4);
+    writeValue<uint32_t>(out, version);
+    writeValue<uint32_t>(out, static_cast<uint32_t>(tables.size()));
+    writeValue<uint32_t>(out, 0);
+    writeValue<double>(out, startJd);
+    writeValue<double>(out, endJd);
+
+    uint64_t offset = headerSize + tables.size() * bodyRecordSize;
+    for (const BodyTable& table : tables) {
+        char name[16] = {};
+        std::strncpy(name, table.body.name.c_str(), sizeof(name) - 1);
+        out.write(name, sizeof(name));
+        writeValue<int32_t>(out, table.body.center);
+        writeValue<uint32_t>(out, table.body.coefficientCount);
+        writeValue<double>(out, table.body.granuleDays);
+        writeValue<uint32_t>(out, table.body.granuleCount);
+        writeValue<uint32_t>(out, 0);
+        writeValue<uint64_t>(out, offset);
+        offset += table.coefficients.size() * sizeof(double);
+    }
+    for (const BodyTable& table : tables) {
+        out.write(reinterpret_cast<const char*>(table.coefficients.data()), table.coefficients.size() * sizeof(double));
+    }
+    return out.good();
+}
+
+double Ephemeris::julianDate(int year, int month, int day) {
+    // Fliegel & Van Flandern day number, minus half a day for 0h UT
+    int a = (14 - month) / 12;
+    int y = year + 4800 - a;
+    int m = month + 12 * a - 3;
+    long dayNumber = day + (153 * m + 2) / 5 + 365L * y + y / 4 - y / 100 + y / 400 - 32045;
+    return dayNumber - 0.5;
+}
+
+bool Ephemeris::parseDate(const std::string& text, double& julianDate) {
+    int year = 0, month = 0, day = 0;
+    if (std::sscanf(text.c_str(), "%d-%d-%d", &year, &month, &day) != 3 || month < 1 || month > 12 || day < 1 ||
+        day > 31) {
+        return false;
+    }
+    julianDate = Ephemeris::julianDate(year, month, day);
+    return true;
+}
+
+std::string Ephemeris::formatDate(double julianDate) {
+    // Inverse of julianDate (Richards' algorithm)
+    long j = static_cast<long>(std::floor(julianDate + 0.5));
+    long f = j + 1401 + (((4 * j + 274277) / 146097) * 3) / 4 - 38;
+    long e = 4 * f + 3;
+    long h = 5 * ((e % 1461) / 4) + 2;
+    int day = static_cast<int>((h % 153) / 5 + 1);
+    int month = static_cast<int>((h / 153 + 2) % 12 + 1);
+    long year = e / 1461 - 4716 + (12 + 2 - month) / 12;
+    char text[32];
+    std::snprintf(text, sizeof(text), "%04ld-%02d-%02d", year, month, day);
+    return text;
+}
@@ -0,0 +1,204 @@
+#include "include/simulation/SceneFile.hpp"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace glm;
+
+namespace {
+
+bool fail(const std::string& path, int lineNumber, const std::string& message) {
+    std::cerr << "Scene " << path << ":" << lineNumber << ": " << message << std::endl;
+    return false;
+}
+
+}
+
+bool SceneFile::load(const std::string& path, SolarSystem& system) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open scene file: " << path << std::endl;
+        return false;
+    }
+
+    SolarSystem loaded;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream fields(line);
+        std::string record;
+        if (!(fields >> record)) {
+            continue;
+        }
+
+        if (record == "body") {
+            std::string name, parentName, texturePath;
+            int isEmissive = 0;
+            float scale, orbitRadius, orbitSpeed, orbitPhase, rotationSpeed;
+            vec3 position;
+            if (!(fields >> name >> parentName >> isEmissive >> scale >> orbitRadius >> orbitSpeed >> orbitPhase >>
+                  rotationSpeed >> position.x >> position.y >> position.z >> texturePath)) {
+                return fail(path, lineNumber, "malformed body record");
+            }
+            int parent = -1;
+            if (parentName != "-") {
+                parent = loaded.findBody(parentName);
+                if (parent < 0) {
+                    return fail(path, lineNumber, "unknown parent '" + parentName + "'");
+                }
+            }
+            CelestialBody body = CelestialBody::create(scale, orbitRadius, orbitSpeed, rotationSpeed);
+            body.orbitPhase = orbitPhase;
+            body.position = position;
+            loaded.addBody(name, texturePath, body, parent, isEmissive != 0);
+        } else if (record == "ring") {
+            std::string bodyName, texturePath;
+            PlanetRing ring;
+            if (!(fields >> bodyName >> ring.innerRadius >> ring.outerRadius >> ring.segments >> ring.tilt >>
+                  texturePath)) {
+                return fail(path, lineNumber, "malformed ring record");
+            }
+            int planet = loaded.findBody(bodyName);
+            if (planet < 0) {
+                return fail(path, lineNumber, "unknown body '" + bodyName + "'");
+            }
+            if (ring.segments < 3) {
+                return fail(path, lineNumber, "a ring needs at least 3 segments");
+            }
+            loaded.rings.push_back(ring);
+            loaded.ringPlanets.push_back(planet);
+            loaded.ringTexturePaths.push_back(texturePath);
+        } else if (record == "comet") {
+            vec3 center;
+            float semiMajorAxis, eccentricity, startAngle;
+            int maxTrailPoints;
+            std::string texturePath;
+            if (!(fields >> center.x >> center.y >> center.z >> semiMajorAxis >> eccentricity >> startAngle >>
+                  maxTrailPoints >> texturePath)) {
+                return fail(path, lineNumber, "malformed comet record");
+            }
+            if (!(semiMajorAxis > 0.0f)) {
+                return fail(path, lineNumber, "a comet's semi-major axis must be positive");
+            }
+            // 1 and above is an open orbit, which the ellipse formula in Comet::evaluate can't place
+            if (!(eccentricity >= 0.0f && eccentricity < 1.0f)) {
+                return fail(path, lineNumber, "a comet's eccentricity must be at least 0 and below 1");
+            }
+            if (maxTrailPoints < 1) {
+                return fail(path, lineNumber, "a comet needs at least 1 trail point");
+            }
+            Comet comet = Comet::create(center, semiMajorAxis, eccentricity);
+            comet.startAngle = startAngle;
+            comet.maxTrailPoints = maxTrailPoints;
+            loaded.comets.push_back(comet);
+            loaded.cometTexturePaths.push_back(texturePath);
+        } else if (record == "atmosphere") {
+            std::string bodyName;
+            Atmosphere atmosphere;
+            if (!(fields >> bodyName >> atmosphere.color.x >> atmosphere.color.y >> atmosphere.color.z >>
+                  atmosphere.thickness >> atmosphere.rayleigh.x >> atmosphere.rayleigh.y >> atmosphere.rayleigh.z >>
+                  atmosphere.mie)) {
+                return fail(path, lineNumber, "malformed atmosphere record");
+            }
+            int body = loaded.findBody(bodyName);
+            if (body < 0) {
+                return fail(path, lineNumber, "unknown body '" + bodyName + "'");
+            }
+            const vec3& rayleigh = atmosphere.rayleigh;
+            if (atmosphere.thickness < 0.0f || atmosphere.mie < 0.0f || rayleigh.x < 0.0f || rayleigh.y < 0.0f ||
+                rayleigh.z < 0.0f) {
+                return fail(path, lineNumber, "atmosphere thickness and optical depths can't be negative");
+            }
+            loaded.atmospheres[body] = atmosphere;
+        } else if (record == "light") {
+            std::string bodyName;
+            StarLight light;
+            if (!(fields >> bodyName >> light.color.x >> light.color.y >> light.color.z >> light.range)) {
+                return fail(path, lineNumber, "malformed light record");
+            }
+            int body = loaded.findBody(bodyName);
+            if (body < 0) {
+                return fail(path, lineNumber, "unknown body '" + bodyName + "'");
+            }
+            if (!loaded.emissive[body]) {
+                return fail(path, lineNumber, "'" + bodyName + "' isn't emissive");
+            }
+            if (!(light.range > 0.0f)) {
+                return fail(path, lineNumber, "a light's range must be positive");
+            }
+            loaded.lights[body] = light;
+        } else if (record == "version") {
+            int fileVersion = 0;
+            if (!(fields >> fileVersion) || fileVersion > version) {
+                return fail(path, lineNumber, "unsupported scene version");
+            }
+        } else {
+            return fail(path, lineNumber, "unknown record '" + record + "'");
+        }
+    }
+
+    if (loaded.bodies.empty()) {
+        std::cerr << "Scene file has no bodies: " << path << std::endl;
+        return false;
+    }
+
+    loaded.placeInitialOrbits();
+    system = std::move(loaded);
+    return true;
+}
+
+bool SceneFile::save(const std::string& path, const SolarSystem& system) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to write scene file: " << path << std::endl;
+        return false;
+    }
+
+    file << "# SolarScope scene (see include/simulation/SceneFile.hpp)\n";
+    file << "version " << version << "\n";
+    file << std::setprecision(7);
+
+    for (size_t i = 0; i < system.bodies.size(); ++i) {
+        const CelestialBody& body = system.bodies[i];
+        vec3 position = system.parents[i] < 0 ? body.position : vec3(0.0f);
+        file << "body " << system.names[i] << " " << (system.parents[i] < 0 ? "-" : system.names[system.parents[i]])
+             << " " << (system.emissive[i] ? 1 : 0) << " " << body.scale.x << " " << body.orbitRadius << " "
+             << body.orbitSpeed << " " << body.orbitPhase << " " << body.rotationSpeed << " " << position.x << " "
+             << position.y << " " << position.z << " " << system.texturePaths[i] << "\n";
+    }
+    for (size_t i = 0; i < system.rings.size(); ++i) {
+        const PlanetRing& ring = system.rings[i];
+        file << "ring " << system.names[system.ringPlanets[i]] << " " << ring.innerRadius << " " << ring.outerRadius
+             << " " << ring.segments << " " << ring.tilt << " " << system.ringTexturePaths[i] << "\n";
+    }
+    for (size_t i = 0; i < system.bodies.size(); ++i) {
+        const Atmosphere& atmosphere = system.atmospheres[i];
+        if (!atmosphere.isPresent()) {
+            continue;
+        }
+        file << "atmosphere " << system.names[i] << " " << atmosphere.color.x << " " << atmosphere.color.y << " "
+             << atmosphere.color.z << " " << atmosphere.thickness << " " << atmosphere.rayleigh.x << " "
+             << atmosphere.rayleigh.y << " " << atmosphere.rayleigh.z << " " << atmosphere.mie << "\n";
+    }
+    for (size_t i = 0; i < system.bodies.size(); ++i) {
+        if (!system.emissive[i]) {
+            continue;
+        }
+        const StarLight& light = system.lights[i];
+        file << "light " << system.names[i] << " " << light.color.x << " " << light.color.y << " " << light.color.z
+             << " " << light.range << "\n";
+    }
+    for (size_t i = 0; i < system.comets.size(); ++i) {
+        const Comet& comet = system.comets[i];
+        file << "comet " << comet.orbitCenter.x << " " << comet.orbitCenter.y << " " << comet.orbitCenter.z << " "
+             << comet.semiMajorAxis << " " << comet.eccentricity << " " << comet.startAngle << " "
+             << comet.maxTrailPoints << " " << system.cometTexturePaths[i] << "\n";
+    }
+    return file.good();
+}
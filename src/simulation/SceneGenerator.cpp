@@ -0,0 +1,137 @@
+#include "include/simulation/SceneGenerator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace glm;
+
+namespace {
+
+const char* planetTextures[] = {
+    "textures/planet/mercury.jpg", "textures/planet/venus.jpg",  "textures/planet/earth.jpg",
+    "textures/planet/mars.jpg",    "textures/planet/jupiter.jpg", "textures/planet/saturn.jpg",
+    "textures/planet/uranus.jpg",  "textures/planet/neptune.jpg",
+};
+// Atmosphere::preset for each of planetTextures
+const char* planetAtmospheres[] = {"mercury", "venus", "earth", "mars", "jupiter", "saturn", "uranus", "neptune"};
+const char* moonTexture = "textures/planet/moon.jpg";
+
+// std::mt19937 output is fixed by the standard; the float/int mapping is done here
+class Random {
+public:
+    explicit Random(uint32_t seed) : engine(seed) {}
+
+    // Uniform in [0, 1)
+    float next() { return (engine() >> 8) * (1.0f / 16777216.0f); }
+    float range(float low, float high) { return low + (high - low) * next(); }
+    int below(int count) { return static_cast<int>(next() * count); }
+
+private:
+    std::mt19937 engine;
+};
+
+// Orbital speed falling off with distance like Kepler's third law, matching Mercury's 2.0 at radius 8
+float keplerSpeed(float orbitRadius) {
+    return 2.0f * std::pow(8.0f / orbitRadius, 1.5f);
+}
+
+void addMoons(SolarSystem& system, Random& random, const SceneGenerator::Options& options, int parent, int depth) {
+    if (depth > options.moonDepth) {
+        return;
+    }
+    float parentScale = system.bodies[parent].scale.x;
+    for (int i = 0; i < options.moonsPerBody; ++i) {
+        float scale = std::max(0.02f, parentScale * random.range(0.15f, 0.35f)); // Stay above isVisible's cutoff
+        float orbitRadius = parentScale * 1.5f + (i + 1) * parentScale * random.range(0.8f, 1.4f);
+        CelestialBody moon =
+            CelestialBody::create(scale, orbitRadius, random.range(2.0f, 5.0f), random.range(-10.0f, 10.0f));
+        moon.orbitPhase = random.range(0.0f, 360.0f);
+        int index = system.addBody(system.names[parent] + "_" + std::to_string(i), moonTexture, moon, parent);
+        addMoons(system, random, options, index, depth + 1);
+    }
+}
+
+}
+
+SolarSystem SceneGenerator::generate(const Options& options) {
+    SolarSystem system;
+    Random random(options.seed);
+
+    CelestialBody star = CelestialBody::create(4.0f, 0.0f, 0.0f, 15.0f);
+    star.position = vec3(0.0f, 0.0f, -20.0f);
+    int starIndex = system.addBody("sun", "textures/planet/sun.jpg", star, -1, true);
+
+    // Planets, sorted outward so the renderer's sun-outward order still holds
+    std::vector<float> orbitRadii;
+    for (int i = 0; i < options.planets; ++i) {
+        orbitRadii.push_back(random.range(options.innerOrbit, options.outerOrbit));
+    }
+    std::sort(orbitRadii.begin(), orbitRadii.end());
+
+    std::vector<int> planetIndices;
+    for (int i = 0; i < options.planets; ++i) {
+        // Mostly rocky sizes with the occasional gas giant
+        float scale = random.next() < 0.15f ? random.range(1.0f, 3.4f) : random.range(0.1f, 0.5f);
+        CelestialBody planet =
+            CelestialBody::create(scale, orbitRadii[i], keplerSpeed(orbitRadii[i]), random.range(-40.0f, 40.0f));
+        planet.orbitPhase = random.range(0.0f, 360.0f);
+        int texture = random.below(sizeof(planetTextures) / sizeof(planetTextures[0]));
+        int index = system.addBody("planet" + std::to_string(i), planetTextures[texture], planet, starIndex, false,
+                                   Atmosphere::preset(planetAtmospheres[texture]));
+        planetIndices.push_back(index);
+        addMoons(system, random, options, index, 1);
+    }
+
+    // Rings on distinct random planets (partial Fisher-Yates shuffle)
+    int ringCount = std::min(options.ringedPlanets, options.planets);
+    for (int i = 0; i < ringCount; ++i) {
+        int pick = i + random.below(options.planets - i);
+        std::swap(planetIndices[i], planetIndices[pick]);
+
+        PlanetRing ring = PlanetRing::createSaturnRings();
+        ring.innerRadius = random.range(1.2f, 1.5f);
+        ring.outerRadius = ring.innerRadius + random.range(0.4f, 1.0f);
+        ring.tilt = random.range(-25.0f, 25.0f);
+        system.rings.push_back(ring);
+        system.ringPlanets.push_back(planetIndices[i]);
+        system.ringTexturePaths.push_back("textures/planet/saturn_rings.png");
+    }
+
+    // Asteroid belt halfway out, thin enough that the orbital plane still reads
+    float beltCenter = 0.5f * (options.innerOrbit + options.outerOrbit);
+    float beltWidth = 0.1f * (options.outerOrbit - options.innerOrbit);
+    for (int i = 0; i < options.asteroids; ++i) {
+        float orbitRadius = beltCenter + random.range(-beltWidth, beltWidth);
+        CelestialBody asteroid = CelestialBody::create(
+            random.range(0.02f, 0.06f), orbitRadius, keplerSpeed(orbitRadius), random.range(-60.0f, 60.0f));
+        asteroid.orbitPhase = random.range(0.0f, 360.0f);
+        system.addBody("asteroid" + std::to_string(i), moonTexture, asteroid, starIndex);
+    }
+
+    for (int i = 0; i < options.comets; ++i) {
+        Comet comet = Comet::create(star.position, random.range(20.0f, options.outerOrbit), random.range(0.5f, 0.9f));
+        comet.startAngle = random.range(0.0f, 6.2831853f);
+        comet.maxTrailPoints = options.maxTrailPoints;
+        system.comets.push_back(comet);
+        system.cometTexturePaths.push_back("textures/comet/comet.jpg");
+    }
+
+    // Companion stars between the planets, tinted from red dwarf to blue giant; their light
+    // only reaches the neighbouring orbits
+    for (int i = 0; i < options.companionStars; ++i) {
+        float orbitRadius = random.range(options.innerOrbit, options.outerOrbit);
+        CelestialBody companion = CelestialBody::create(
+            random.range(0.6f, 2.0f), orbitRadius, keplerSpeed(orbitRadius), random.range(5.0f, 20.0f));
+        companion.orbitPhase = random.range(0.0f, 360.0f);
+        float temperature = random.next();
+        vec3 color = mix(vec3(1.0f, 0.55f, 0.35f), vec3(0.65f, 0.8f, 1.0f), temperature);
+        StarLight light = StarLight::create(color, random.range(8.0f, 20.0f));
+        int index = system.addBody("star" + std::to_string(i), "textures/planet/sun.jpg", companion, starIndex, true);
+        system.lights[index] = light;
+    }
+
+    system.placeInitialOrbits();
+    return system;
+}
@@ -0,0 +1,34 @@
+#include "include/simulation/SimulationClock.hpp"
+#include <cmath>
+
+SimulationClock::SimulationClock()
+    : stepSeconds(defaultStepSeconds),
+      maxStepsPerFrame(defaultMaxStepsPerFrame),
+      accumulator(0.0),
+      steps(0),
+      stepsThisFrame(0),
+      dropped(0.0) {}
+
+void SimulationClock::beginFrame(float frameSeconds) {
+    if (frameSeconds > 0.0f) {
+        accumulator += frameSeconds;
+    }
+    stepsThisFrame = 0;
+}
+
+bool SimulationClock::step() {
+    if (accumulator < stepSeconds) {
+        return false;
+    }
+    if (stepsThisFrame >= maxStepsPerFrame) {
+        // Keep the fraction so interpolation stays continuous, drop the whole steps
+        double excess = std::floor(accumulator / stepSeconds) * stepSeconds;
+        dropped += excess;
+        accumulator -= excess;
+        return false;
+    }
+    accumulator -= stepSeconds;
+    steps++;
+    stepsThisFrame++;
+    return true;
+}
@@ -0,0 +1,484 @@
+#include "include/simulation/SolarSystem.hpp"
+#include <algorithm>
+#include <chrono>
+
+using namespace glm;
+
+SolarSystem::SolarSystem()
+    : ephemerisEpochJd(0.0),
+      blackHole(BlackHole::create()),
+      simulationTime(0.0),
+      comparisonMode(false),
+      posedTime(0.0),
+      orbitsUpToDate(false) {}
+
+SolarSystem SolarSystem::createDefault() {
+    SolarSystem system;
+
+    // Setup celestial bodies with realistic proportions
+    // Using a scale where Earth = 0.3f as base reference
+
+    // SUN - Center of the system
+    CelestialBody sun = CelestialBody::create(4.0f,   // Scale
+                                              0.0f,   // Orbit radius
+                                              0.0f,   // Orbit speed
+                                              15.0f); // Rotation speed
+    sun.position = vec3(0.0f, 0.0f, -20.0f);
+    int sunIndex = system.addBody("sun", "textures/planet/sun.jpg", sun, -1, true);
+
+    // MERCURY - Smallest planet, closest orbit
+    system.addBody("mercury",
+                   "textures/planet/mercury.jpg",
+                   CelestialBody::create(0.11f, // Small size
+                                         8.0f,  // Safe distance from sun
+                                         2.0f,  // Fastest orbital speed
+                                         35.0f  // Fast rotation
+                                         ),
+                   sunIndex);
+
+    // VENUS - Second planet
+    system.addBody("venus",
+                   "textures/planet/venus.jpg",
+                   CelestialBody::create(0.28f, // Venus size
+                                         10.0f, // Safe distance from mercury
+                                         1.6f,  // Orbital speed
+                                         -12.0f // Slow retrograde rotation
+                                         ),
+                   sunIndex);
+
+    // EARTH - Third planet
+    int earthIndex = system.addBody("earth",
+                                    "textures/planet/earth.jpg",
+                                    CelestialBody::create(0.35f, // Earth size
+                                                          12.0f, // Safe distance from venus
+                                                          1.0f,  // Earth orbital speed reference
+                                                          20.0f  // Earth rotation speed
+                                                          ),
+                                    sunIndex);
+
+    // MOON - Orbits Earth
+    system.addBody("moon",
+                   "textures/planet/moon.jpg",
+                   CelestialBody::create(0.08f, // Small moon size
+                                         1.2f,  // Distance from Earth
+                                         4.0f,  // Fast orbit around Earth
+                                         5.0f   // Moon rotation
+                                         ),
+                   earthIndex);
+
+    // MARS - Fourth planet
+    system.addBody("mars",
+                   "textures/planet/mars.jpg",
+                   CelestialBody::create(0.16f, // Mars size
+                                         15.0f, // Safe distance from Earth
+                                         0.8f,  // Slower orbital speed than Earth
+                                         18.0f  // Rotation speed
+                                         ),
+                   sunIndex);
+
+    // JUPITER - Fifth planet, largest
+    system.addBody("jupiter",
+                   "textures/planet/jupiter.jpg",
+                   CelestialBody::create(3.36f, // Large size
+                                         20.0f, // Safe distance from Mars
+                                         0.5f,  // Slower orbital speed
+                                         30.0f  // Fast rotation speed
+                                         ),
+                   sunIndex);
+
+    // SATURN - Sixth planet with rings
+    int saturnIndex = system.addBody("saturn",
+                                     "textures/planet/saturn.jpg",
+                                     CelestialBody::create(2.82f, // Large size
+                                                           36.0f, // Extra distance from Jupiter for the rings
+                                                           0.35f, // Slow orbital speed
+                                                           28.0f  // Fast rotation speed
+                                                           ),
+                                     sunIndex);
+
+    // URANUS - Seventh planet
+    system.addBody("uranus",
+                   "textures/planet/uranus.jpg",
+                   CelestialBody::create(1.4f,  // Medium size
+                                         50.0f, // Extra distance from Saturn to avoid ring collision
+                                         0.25f, // Very slow orbital speed
+                                         -15.0f // Retrograde rotation
+                                         ),
+                   sunIndex);
+
+    // NEPTUNE - Outermost planet
+    system.addBody("neptune",
+                   "textures/planet/neptune.jpg",
+                   CelestialBody::create(1.17f, // Medium size
+                                         55.0f, // Safe distance from Uranus
+                                         0.2f,  // Slowest orbital speed
+                                         18.0f  // Normal rotation speed
+                                         ),
+                   sunIndex);
+
+    // Atmospheres of the planets that have one
+    for (size_t i = 0; i < system.bodies.size(); ++i) {
+        system.atmospheres[i] = Atmosphere::preset(system.names[i]);
+    }
+
+    // Saturn's rings
+    system.rings.push_back(PlanetRing::createSaturnRings());
+    system.ringPlanets.push_back(saturnIndex);
+    system.ringTexturePaths.push_back("textures/planet/saturn_rings.png");
+
+    // Comets on elliptical orbits around the sun's home position
+    system.comets.push_back(Comet::create(vec3(0.0f, 0.0f, -20.0f), 45.0f, 0.85f));
+    system.cometTexturePaths.push_back("textures/comet/comet.jpg");
+
+    Comet comet2 = Comet::create(vec3(0.0f, 0.0f, -20.0f), 25.0f, 0.7f);
+    comet2.startAngle = 180.0f; // Start on opposite side
+    system.comets.push_back(comet2);
+    system.cometTexturePaths.push_back("textures/comet/comet.jpg");
+
+    system.placeInitialOrbits();
+    return system;
+}
+
+int SolarSystem::addBody(const std::string& name,
+                         const std::string& texturePath,
+                         const CelestialBody& body,
+                         int parent,
+                         bool isEmissive,
+                         const Atmosphere& atmosphere) {
+    bodies.push_back(body);
+    names.push_back(name);
+    texturePaths.push_back(texturePath);
+    parents.push_back(parent);
+    emissive.push_back(isEmissive);
+    atmospheres.push_back(atmosphere);
+    lights.push_back(StarLight::standard());
+    if (ephemeris) {
+        ephemerisBodies.push_back(-1);
+        ephemerisScales.push_back(0.0f);
+    }
+    transforms.add(parent);
+    orbitsUpToDate = false;
+    return static_cast<int>(bodies.size()) - 1;
+}
+
+int SolarSystem::findBody(const std::string& name) const {
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+vec3 SolarSystem::lightPosition() const {
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        if (emissive[i]) {
+            return bodies[i].position;
+        }
+    }
+    return vec3(0.0f);
+}
+
+void SolarSystem::collectLights(std::vector<vec3>& positions, std::vector<StarLight>& lightSources) const {
+    positions.clear();
+    lightSources.clear();
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        if (emissive[i]) {
+            positions.push_back(bodies[i].position);
+            lightSources.push_back(lights[i]);
+        }
+    }
+}
+
+void SolarSystem::update(float animationDt, float currentTime, float elapsedSeconds) {
+    updateBodies(animationDt, currentTime);
+    updateComets(currentTime, elapsedSeconds);
+}
+
+void SolarSystem::updateBodies(float animationDt, float currentTime) {
+    simulationTime += animationDt;
+    poseBodies(simulationTime, currentTime);
+}
+
+void SolarSystem::step(float animationDt, float currentTime, float elapsedSeconds) {
+    simulationTime += animationDt;
+    // Paused: trails neither grow nor age, so nothing is copied or uploaded for them
+    if (animationDt != 0.0f) {
+        updateComets(currentTime, elapsedSeconds);
+    }
+}
+
+void SolarSystem::poseBodies(double time, float currentTime) {
+    if (blackHole.active) {
+        // Don't do normal orbital updates during black hole effect - it overrides positions
+        updateBlackHole(currentTime);
+        syncTransforms();
+    } else if (comparisonMode) {
+        updateComparisonLayout(time);
+        syncTransforms();
+    } else {
+        updateOrbits(time);
+    }
+    for (Comet& comet : comets) {
+        comet.evaluate(time);
+    }
+}
+
+void SolarSystem::updateOrbits(double time) {
+    if (time == posedTime && orbitsUpToDate && scheduler.staleBodies() == 0) {
+        return;
+    }
+    if (!orbitsUpToDate) {
+        scheduler.invalidate();
+    }
+
+    // Orbits are evaluated from the simulation time and are local to the parent; the hierarchy
+    // adds up positions in one parent-first pass. Bodies the scheduler skips keep their last
+    // local offset and still follow their parent.
+    scheduler.plan(*this, time, dueBodies);
+    double baseAngle = orbitDegreesPerSecond * time;
+    double jd = julianDateAt(time);
+    auto start = std::chrono::steady_clock::now();
+    for (int index : dueBodies) {
+        evaluateOrbit(index, time, baseAngle, jd);
+    }
+    scheduler.finish(dueBodies.size(),
+                     std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+
+    transforms.update();
+    for (int index : transforms.updatedNodes()) {
+        bodies[index].position = transforms.worldTranslation(index);
+    }
+    posedTime = time;
+    orbitsUpToDate = true;
+}
+
+void SolarSystem::evaluateOrbit(int index, double time, double baseAngle, double jd) {
+    // Bodies without a parent stay where they are
+    CelestialBody& body = bodies[index];
+    body.rotationAngle = body.rotationAt(time);
+    if (ephemeris && ephemerisBodies[index] >= 0) {
+        transforms.setLocal(index, ephemerisOffset(index, jd), body.rotationAngle, body.meshScale());
+    } else if (parents[index] >= 0) {
+        transforms.setLocal(index, body.orbitOffset(baseAngle), body.rotationAngle, body.meshScale());
+    } else {
+        transforms.setLocal(index, body.position, body.rotationAngle, body.meshScale(), false);
+    }
+}
+
+bool SolarSystem::attachEphemeris(std::shared_ptr<const Ephemeris> table, double epochJd) {
+    ephemeris = std::move(table);
+    ephemerisEpochJd = epochJd;
+    ephemerisBodies.assign(bodies.size(), -1);
+    ephemerisScales.assign(bodies.size(), 0.0f);
+
+    // Sampling the whole table once puts each body's mean distance where its hand-tuned orbit was,
+    // so real directions and eccentricities show without planets colliding at display scale
+    const int distanceSamples = 512;
+    int matched = 0;
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        int entry = ephemeris->findBody(names[i]);
+        if (entry < 0 || parents[i] < 0) {
+            continue;
+        }
+        int center = ephemeris->bodyList()[entry].center;
+        bool centerMatches =
+            center < 0 ? emissive[parents[i]] : ephemeris->bodyList()[center].name == names[parents[i]];
+        if (!centerMatches) {
+            continue;
+        }
+
+        double meanDistance = 0.0;
+        double span = ephemeris->endJd() - ephemeris->startJd();
+        for (int sample = 0; sample < distanceSamples; ++sample) {
+            double jd = ephemeris->startJd() + span * (sample + 0.5) / distanceSamples;
+            meanDistance += length(ephemeris->position(entry, jd));
+        }
+        meanDistance /= distanceSamples;
+        if (meanDistance <= 0.0) {
+            continue;
+        }
+        ephemerisBodies[i] = entry;
+        ephemerisScales[i] = static_cast<float>(bodies[i].orbitRadius / meanDistance);
+        matched++;
+    }
+
+    if (matched == 0) {
+        ephemeris.reset();
+        ephemerisBodies.clear();
+        ephemerisScales.clear();
+        return false;
+    }
+    orbitsUpToDate = false;
+    updateOrbits(simulationTime);
+    return true;
+}
+
+vec3 SolarSystem::ephemerisOffset(int index, double jd) const {
+    // Ecliptic north is display up; x and y keep the counter-clockwise sense of the simulated orbits
+    dvec3 ecliptic = ephemeris->position(ephemerisBodies[index], jd);
+    return vec3(ecliptic.x, ecliptic.z, ecliptic.y) * ephemerisScales[index];
+}
+
+void SolarSystem::syncTransforms() {
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        const CelestialBody& body = bodies[i];
+        transforms.setLocal(i, body.position, body.rotationAngle, body.meshScale(), false);
+    }
+    transforms.update();
+    orbitsUpToDate = false;
+}
+
+void SolarSystem::updateComets(float currentTime, float elapsedSeconds) {
+    vec3 sunPosition = lightPosition();
+    for (Comet& comet : comets) {
+        comet.update(simulationTime, sunPosition, currentTime, elapsedSeconds);
+    }
+}
+
+void SolarSystem::refreshBodies(float currentTime) {
+    orbitsUpToDate = false;
+    poseBodies(simulationTime, currentTime);
+}
+
+void SolarSystem::seek(double time, float currentTime) {
+    simulationTime = time;
+    orbitsUpToDate = false;
+    for (Comet& comet : comets) {
+        comet.trail.clear();
+        comet.trailVersion++;
+    }
+    update(0.0f, currentTime, 0.0f);
+}
+
+void SolarSystem::placeInitialOrbits() {
+    // Stagger planets 45 degrees apart; moons start at angle 0 around their planet
+    float angle = 0.0f;
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        if (parents[i] < 0) {
+            continue;
+        }
+        bool orbitsStar = emissive[parents[i]];
+        bodies[i].update(bodies[parents[i]].position, orbitsStar ? angle : 0.0f, 0.0f);
+        if (orbitsStar) {
+            angle += 45.0f;
+        }
+    }
+    syncTransforms();
+
+    // Store these as the RESET positions (what we return to with R key)
+    blackHole.resetPositions.clear();
+    blackHole.resetScales.clear();
+    for (const CelestialBody& body : bodies) {
+        blackHole.resetPositions.push_back(body.position);
+        blackHole.resetScales.push_back(body.scale);
+    }
+}
+
+void SolarSystem::activateBlackHole(float currentTime) {
+    blackHole.active = true;
+    blackHole.activationTime = currentTime;
+
+    // Bodies the LOD skipped start from where they are now, not from a few frames ago
+    if (!comparisonMode && scheduler.staleBodies() > 0) {
+        orbitsUpToDate = false;
+        updateOrbits(posedTime);
+    }
+
+    // Capture CURRENT positions, not the stored reset positions
+    blackHole.originalPositions.clear();
+    blackHole.originalScales.clear();
+    for (const CelestialBody& body : bodies) {
+        blackHole.originalPositions.push_back(body.position);
+        blackHole.originalScales.push_back(body.scale);
+    }
+}
+
+void SolarSystem::resetBlackHole() {
+    blackHole.active = false;
+    blackHole.strength = 0.0f;
+
+    // Reset all bodies to normal orbital positions (not the X-pressed positions)
+    for (size_t i = 0; i < bodies.size() && i < blackHole.resetPositions.size(); ++i) {
+        bodies[i].position = blackHole.resetPositions[i];
+        bodies[i].scale = blackHole.resetScales[i];
+    }
+    syncTransforms();
+}
+
+void SolarSystem::collectShadowCasters(std::vector<vec3>& positions, std::vector<float>& radii) const {
+    positions.clear();
+    radii.clear();
+    if (comparisonMode) {
+        return;
+    }
+    for (size_t i = 0; i < bodies.size() && positions.size() < maxShadowCasters; ++i) {
+        if (emissive[i]) {
+            continue;
+        }
+        positions.push_back(bodies[i].position);
+        radii.push_back(bodies[i].scale.x);
+    }
+}
+
+void SolarSystem::updateBlackHole(float currentTime) {
+    float elapsed = currentTime - blackHole.activationTime;
+    float effectDuration = 6.0f; // 6 second effect for better visibility
+    blackHole.strength = std::min(1.0f, elapsed / effectDuration);
+
+    // Shrink to completely invisible: goes from 1.0 to 0.0
+    float shrinkFactor = std::max(0.0f, 1.0f - blackHole.strength);
+
+    // Apply effect to ALL bodies including the sun - they all go to the black hole center
+    for (size_t i = 0; i < bodies.size() && i < blackHole.originalPositions.size(); ++i) {
+        const vec3& start = blackHole.originalPositions[i];
+        bodies[i].position = start + blackHole.strength * (blackHole.position - start);
+        bodies[i].scale = blackHole.originalScales[i] * shrinkFactor;
+    }
+}
+
+void SolarSystem::updateComparisonLayout(double time) {
+    // Line up planets by size from smallest to largest, moving away from the sun.
+    // The sun sits slightly to the side so it doesn't block planets.
+    const float baseSpacing = 8.0f;   // Base distance between each planet
+    const float ringExtra = 4.0f;     // Extra spacing around ringed planets
+    const float startDistance = 5.0f; // Distance from sun position to first planet
+
+    std::vector<int> planets;
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        if (emissive[i]) {
+            bodies[i].position = vec3(-15.0f, 0.0f, -20.0f);
+        } else if (parents[i] >= 0 && emissive[parents[i]]) {
+            planets.push_back(static_cast<int>(i));
+        }
+    }
+    std::stable_sort(planets.begin(), planets.end(), [this](int a, int b) {
+        return bodies[a].scale.x < bodies[b].scale.x;
+    });
+
+    float extra = 0.0f;
+    for (size_t slot = 0; slot < planets.size(); ++slot) {
+        int index = planets[slot];
+        bool ringed = std::find(ringPlanets.begin(), ringPlanets.end(), index) != ringPlanets.end();
+        if (ringed) {
+            extra += ringExtra;
+        }
+        bodies[index].position = vec3(startDistance + baseSpacing * slot + extra, 0.0f, -20.0f);
+        if (ringed) {
+            extra += ringExtra * 1.5f;
+        }
+    }
+
+    // Moons sit just above and beside their planet
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        int parent = parents[i];
+        if (parent >= 0 && !emissive[parent]) {
+            bodies[i].position = bodies[parent].position + vec3(baseSpacing * 0.3f, 2.0f, 0.0f);
+        }
+    }
+
+    // Still allow rotation in comparison mode
+    for (CelestialBody& body : bodies) {
+        body.rotationAngle = body.rotationAt(time);
+    }
+}
@@ -0,0 +1,491 @@
+#include "include/simulation/StateHistory.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+const uint32_t comparisonFlag = 1;
+const uint32_t blackHoleFlag = 2;
+const size_t wordsPerTrailPoint = 5;   // position, age, brightness
+const size_t ageWord = 3;
+const int maxTrailShift = 8;           // Points a trail may grow by between two recorded frames
+
+uint32_t bits(float value) {
+    return std::bit_cast<uint32_t>(value);
+}
+
+float value(uint32_t bits) {
+    return std::bit_cast<float>(bits);
+}
+
+void writeVarint(std::vector<unsigned char>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+uint32_t readVarint(const unsigned char*& in) {
+    uint32_t value = 0;
+    for (int shift = 0;; shift += 7) {
+        unsigned char byte = *in++;
+        value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+}
+
+void writeWord(std::vector<unsigned char>& out, uint32_t word) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<unsigned char>(word >> (8 * i)));
+    }
+}
+
+uint32_t readWord(const unsigned char*& in) {
+    uint32_t word = 0;
+    for (int i = 0; i < 4; ++i) {
+        word |= static_cast<uint32_t>(*in++) << (8 * i);
+    }
+    return word;
+}
+
+// Blocks of eight residuals: a byte marking the nonzero ones; if any, two bytes holding
+// each one's length (1-4 bytes, low bytes first, as 2 bits) and then their bytes
+void packXor(const uint32_t* words, const uint32_t* reference, size_t count, std::vector<unsigned char>& out) {
+    for (size_t block = 0; block < count; block += 8) {
+        size_t blockSize = std::min<size_t>(8, count - block);
+        uint32_t residuals[8];
+        unsigned int mask = 0;
+        unsigned int lengths = 0;
+        for (size_t i = 0; i < blockSize; ++i) {
+            residuals[i] = words[block + i] ^ reference[block + i];
+            if (residuals[i]) {
+                mask |= 1u << i;
+                lengths |= static_cast<unsigned int>((std::bit_width(residuals[i]) + 7) / 8 - 1) << (2 * i);
+            }
+        }
+        out.push_back(static_cast<unsigned char>(mask));
+        if (!mask) {
+            continue;
+        }
+        out.push_back(static_cast<unsigned char>(lengths));
+        out.push_back(static_cast<unsigned char>(lengths >> 8));
+        for (size_t i = 0; i < blockSize; ++i) {
+            if (mask & (1u << i)) {
+                int length = ((lengths >> (2 * i)) & 3) + 1;
+                for (int byte = 0; byte < length; ++byte) {
+                    out.push_back(static_cast<unsigned char>(residuals[i] >> (8 * byte)));
+                }
+            }
+        }
+    }
+}
+
+void unpackXor(const unsigned char*& in, const uint32_t* reference, size_t count, uint32_t* words) {
+    for (size_t block = 0; block < count; block += 8) {
+        size_t blockSize = std::min<size_t>(8, count - block);
+        unsigned int mask = *in++;
+        if (!mask) {
+            std::memcpy(words + block, reference + block, blockSize * sizeof(uint32_t));
+            continue;
+        }
+        unsigned int lengths = in[0] | (in[1] << 8);
+        in += 2;
+        for (size_t i = 0; i < blockSize; ++i) {
+            uint32_t residual = 0;
+            if (mask & (1u << i)) {
+                int length = ((lengths >> (2 * i)) & 3) + 1;
+                for (int byte = 0; byte < length; ++byte) {
+                    residual |= static_cast<uint32_t>(*in++) << (8 * byte);
+                }
+            }
+            words[block + i] = reference[block + i] ^ residual;
+        }
+    }
+}
+
+size_t cometWords(uint32_t trailSize) {
+    return 1 + trailSize * wordsPerTrailPoint;
+}
+
+}
+
+StateHistory::StateHistory()
+    : budgetBytes(64u << 20),
+      nextSegmentId(0),
+      storedBytes(0),
+      framesSinceKeyframe(0),
+      decodedSegmentId(0),
+      decodedFrame(0),
+      hasDecoded(false),
+      showingDecoded(false) {}
+
+void StateHistory::record(const SolarSystem& system, float currentTime) {
+    showingDecoded = false;
+    capture(system, currentTime, scratch);
+    if (!segments.empty() && scratch.simulationTime < newestTime()) {
+        clear();
+    }
+
+    bool keyframe = segments.empty() || framesSinceKeyframe + 1 >= keyframeInterval ||
+                    newest.trailSizes.size() != scratch.trailSizes.size();
+    if (keyframe) {
+        if (!segments.empty()) {
+            segments.back().bytes.shrink_to_fit();
+        }
+        segments.push_back(Segment{nextSegmentId++, {}, {}});
+        framesSinceKeyframe = 0;
+    } else {
+        framesSinceKeyframe++;
+    }
+
+    Segment& segment = segments.back();
+    size_t offset = segment.bytes.size();
+    encode(scratch, keyframe ? nullptr : &newest, segment.bytes);
+    segment.frames.push_back(Frame{scratch.simulationTime, offset});
+    storedBytes += segment.bytes.size() - offset;
+    std::swap(newest, scratch);
+
+    while (storedBytes > budgetBytes && segments.size() > 1) {
+        evictOldest();
+    }
+}
+
+bool StateHistory::restore(double time, SolarSystem& system, float currentTime) {
+    size_t segmentIndex = 0, frame = 0;
+    if (!locate(time, segmentIndex, frame)) {
+        return false;
+    }
+
+    // Roll forward from the keyframe, or from the last restored frame when it is on the way
+    const Segment& segment = segments[segmentIndex];
+    if (showingDecoded && hasDecoded && decodedSegmentId == segment.id && decodedFrame == frame) {
+        return true;
+    }
+    size_t next = 0;
+    if (hasDecoded && decodedSegmentId == segment.id && decodedFrame <= frame) {
+        next = decodedFrame + 1;
+    } else {
+        decode(segment.bytes.data(), nullptr, decoded);
+        decoded.simulationTime = segment.frames[0].simulationTime;
+        next = 1;
+    }
+    for (; next <= frame; ++next) {
+        decode(segment.bytes.data() + segment.frames[next].offset, &decoded, scratch);
+        scratch.simulationTime = segment.frames[next].simulationTime;
+        std::swap(decoded, scratch);
+    }
+    decodedSegmentId = segment.id;
+    decodedFrame = frame;
+    hasDecoded = true;
+
+    apply(decoded, system, currentTime);
+    showingDecoded = true;
+    return true;
+}
+
+void StateHistory::discardAfterRestored() {
+    if (!hasDecoded) {
+        return;
+    }
+    while (!segments.empty() && segments.back().id != decodedSegmentId) {
+        segments.pop_back();
+    }
+    if (segments.empty()) {
+        clear();
+        return;
+    }
+
+    Segment& segment = segments.back();
+    if (decodedFrame + 1 < segment.frames.size()) {
+        segment.bytes.resize(segment.frames[decodedFrame + 1].offset);
+        segment.frames.resize(decodedFrame + 1);
+    }
+    framesSinceKeyframe = static_cast<int>(decodedFrame);
+    newest = decoded;
+
+    storedBytes = 0;
+    for (const Segment& kept : segments) {
+        storedBytes += kept.bytes.size();
+    }
+}
+
+void StateHistory::clear() {
+    segments.clear();
+    storedBytes = 0;
+    framesSinceKeyframe = 0;
+    hasDecoded = false;
+    showingDecoded = false;
+}
+
+size_t StateHistory::frameCount() const {
+    size_t count = 0;
+    for (const Segment& segment : segments) {
+        count += segment.frames.size();
+    }
+    return count;
+}
+
+void StateHistory::capture(const SolarSystem& system, float currentTime, Snapshot& snapshot) {
+    const BlackHole& blackHole = system.blackHole;
+    snapshot.simulationTime = system.simulationTime;
+    snapshot.currentTime = currentTime;
+    snapshot.flags = (system.comparisonMode ? comparisonFlag : 0) | (blackHole.active ? blackHoleFlag : 0);
+
+    std::vector<uint32_t>& words = snapshot.words;
+    words.clear();
+    words.push_back(bits(blackHole.strength));
+    words.push_back(bits(blackHole.activationTime));
+
+    // Orbits are relative to the roots, which only move when set directly (comparison mode)
+    snapshot.rootWords = 0;
+    for (size_t i = 0; i < system.bodies.size(); ++i) {
+        if (system.parents[i] < 0) {
+            const glm::vec3& position = system.bodies[i].position;
+            words.push_back(bits(position.x));
+            words.push_back(bits(position.y));
+            words.push_back(bits(position.z));
+            snapshot.rootWords += 3;
+        }
+    }
+
+    // Everything else about the bodies follows from simulationTime, or from the captured
+    // positions and strength while the black hole pulls them in; only their spin is frozen
+    snapshot.rotationWords = 0;
+    snapshot.originalWords = 0;
+    if (blackHole.active) {
+        for (const CelestialBody& body : system.bodies) {
+            words.push_back(bits(body.rotationAngle));
+        }
+        snapshot.rotationWords = static_cast<uint32_t>(system.bodies.size());
+
+        size_t count = std::min(blackHole.originalPositions.size(), blackHole.originalScales.size());
+        for (const std::vector<glm::vec3>* source : {&blackHole.originalPositions, &blackHole.originalScales}) {
+            for (size_t i = 0; i < count; ++i) {
+                words.push_back(bits((*source)[i].x));
+                words.push_back(bits((*source)[i].y));
+                words.push_back(bits((*source)[i].z));
+            }
+        }
+        snapshot.originalWords = static_cast<uint32_t>(count * 6);
+    }
+
+    snapshot.trailSizes.clear();
+    for (const Comet& comet : system.comets) {
+        words.push_back(bits(comet.lastTrailUpdate));
+        for (const TrailPoint& point : comet.trail) {
+            words.push_back(bits(point.position.x));
+            words.push_back(bits(point.position.y));
+            words.push_back(bits(point.position.z));
+            words.push_back(bits(point.age));
+            words.push_back(bits(point.brightness));
+        }
+        snapshot.trailSizes.push_back(static_cast<uint32_t>(comet.trail.size()));
+    }
+}
+
+void StateHistory::apply(const Snapshot& snapshot, SolarSystem& system, float currentTime) {
+    // Wall-clock timers continue from now, as if the recorded frame had just happened
+    float offset = currentTime - snapshot.currentTime;
+    const uint32_t* words = snapshot.words.data();
+    BlackHole& blackHole = system.blackHole;
+
+    system.simulationTime = snapshot.simulationTime;
+    system.comparisonMode = (snapshot.flags & comparisonFlag) != 0;
+    blackHole.active = (snapshot.flags & blackHoleFlag) != 0;
+    blackHole.strength = value(words[0]);
+    blackHole.activationTime = value(words[1]) + offset;
+    size_t at = 2;
+
+    for (size_t i = 0; i < system.bodies.size() && at < 2 + snapshot.rootWords; ++i) {
+        if (system.parents[i] < 0) {
+            system.bodies[i].position = glm::vec3(value(words[at]), value(words[at + 1]), value(words[at + 2]));
+            at += 3;
+        }
+    }
+    at = 2 + snapshot.rootWords;
+
+    if (snapshot.rotationWords == system.bodies.size()) {
+        for (size_t i = 0; i < system.bodies.size(); ++i) {
+            system.bodies[i].rotationAngle = value(words[at + i]);
+        }
+    }
+    at += snapshot.rotationWords;
+
+    if (snapshot.originalWords > 0) {
+        size_t count = snapshot.originalWords / 6;
+        for (std::vector<glm::vec3>* target : {&blackHole.originalPositions, &blackHole.originalScales}) {
+            target->resize(count);
+            for (glm::vec3& v : *target) {
+                v = glm::vec3(value(words[at]), value(words[at + 1]), value(words[at + 2]));
+                at += 3;
+            }
+        }
+    }
+    if (!blackHole.active && blackHole.resetScales.size() == system.bodies.size()) {
+        for (size_t i = 0; i < system.bodies.size(); ++i) {
+            system.bodies[i].scale = blackHole.resetScales[i];
+        }
+    }
+
+    for (size_t c = 0; c < system.comets.size() && c < snapshot.trailSizes.size(); ++c) {
+        Comet& comet = system.comets[c];
+        comet.lastTrailUpdate = value(words[at++]) + offset;
+        comet.trail.resize(snapshot.trailSizes[c]);
+        for (TrailPoint& point : comet.trail) {
+            point.position = glm::vec3(value(words[at]), value(words[at + 1]), value(words[at + 2]));
+            point.age = value(words[at + 3]);
+            point.brightness = value(words[at + 4]);
+            at += wordsPerTrailPoint;
+        }
+        comet.trailVersion++;
+        comet.evaluate(snapshot.simulationTime);
+    }
+
+    system.refreshBodies(currentTime);
+}
+
+void StateHistory::encode(const Snapshot& current, const Snapshot* previous, std::vector<unsigned char>& out) {
+    // How far each trail moved along: the previous newest point reappears shift places back
+    size_t comets = current.trailSizes.size();
+    shifts.assign(comets, 0);
+    ageSteps.assign(comets, 0.0f);
+    size_t currentAt = 2 + current.rootWords + current.rotationWords + current.originalWords;
+    size_t previousAt = previous ? 2 + previous->rootWords + previous->rotationWords + previous->originalWords : 0;
+    for (size_t c = 0; c < comets; ++c) {
+        uint32_t size = current.trailSizes[c];
+        shifts[c] = static_cast<int>(size);
+        if (previous && previous->trailSizes[c] > 0) {
+            const uint32_t* newestBefore = &previous->words[previousAt + 1];
+            for (uint32_t shift = 0; shift < size && shift <= maxTrailShift; ++shift) {
+                const uint32_t* point = &current.words[currentAt + 1 + shift * wordsPerTrailPoint];
+                if (std::memcmp(point, newestBefore, 3 * sizeof(uint32_t)) == 0) {
+                    shifts[c] = static_cast<int>(shift);
+                    ageSteps[c] = value(point[ageWord]) - value(newestBefore[ageWord]);
+                    break;
+                }
+            }
+        }
+        currentAt += cometWords(size);
+        if (previous) {
+            previousAt += cometWords(previous->trailSizes[c]);
+        }
+    }
+
+    writeVarint(out, current.flags);
+    writeVarint(out, current.rootWords);
+    writeVarint(out, current.rotationWords);
+    writeVarint(out, current.originalWords);
+    writeVarint(out, static_cast<uint32_t>(comets));
+    for (size_t c = 0; c < comets; ++c) {
+        writeVarint(out, current.trailSizes[c]);
+        writeVarint(out, static_cast<uint32_t>(shifts[c]));
+        writeWord(out, bits(ageSteps[c]));
+    }
+    writeWord(out, bits(current.currentTime));
+
+    predict(previous, current);
+    packXor(current.words.data(), reference.data(), current.words.size(), out);
+}
+
+void StateHistory::decode(const unsigned char* bytes, const Snapshot* previous, Snapshot& out) {
+    out.flags = readVarint(bytes);
+    out.rootWords = readVarint(bytes);
+    out.rotationWords = readVarint(bytes);
+    out.originalWords = readVarint(bytes);
+    size_t comets = readVarint(bytes);
+    out.trailSizes.resize(comets);
+    shifts.resize(comets);
+    ageSteps.resize(comets);
+    size_t wordCount = 2 + out.rootWords + out.rotationWords + out.originalWords;
+    for (size_t c = 0; c < comets; ++c) {
+        out.trailSizes[c] = readVarint(bytes);
+        shifts[c] = static_cast<int>(readVarint(bytes));
+        ageSteps[c] = value(readWord(bytes));
+        wordCount += cometWords(out.trailSizes[c]);
+    }
+    out.currentTime = value(readWord(bytes));
+
+    out.words.resize(wordCount);
+    predict(previous, out);
+    unpackXor(bytes, reference.data(), wordCount, out.words.data());
+}
+
+void StateHistory::predict(const Snapshot* previous, const Snapshot& layout) {
+    reference.assign(layout.words.size(), 0);
+    if (!previous) {
+        return;
+    }
+    const std::vector<uint32_t>& before = previous->words;
+
+    // Black hole values, roots and the frozen rotations are most likely unchanged
+    reference[0] = before[0];
+    reference[1] = before[1];
+    size_t at = 2, previousAt = 2;
+    if (layout.rootWords == previous->rootWords) {
+        std::copy_n(before.begin() + previousAt, layout.rootWords, reference.begin() + at);
+    }
+    at += layout.rootWords;
+    previousAt += previous->rootWords;
+    if (layout.rotationWords == previous->rotationWords) {
+        std::copy_n(before.begin() + previousAt, layout.rotationWords, reference.begin() + at);
+    }
+    at += layout.rotationWords;
+    previousAt += previous->rotationWords;
+    if (layout.originalWords == previous->originalWords) {
+        std::copy_n(before.begin() + previousAt, layout.originalWords, reference.begin() + at);
+    }
+    at += layout.originalWords;
+    previousAt += previous->originalWords;
+
+    // Trail points keep their position and brightness and all age by the same step
+    for (size_t c = 0; c < layout.trailSizes.size() && c < previous->trailSizes.size(); ++c) {
+        reference[at] = before[previousAt];
+        uint32_t previousSize = previous->trailSizes[c];
+        for (uint32_t i = shifts[c]; i < layout.trailSizes[c] && i - shifts[c] < previousSize; ++i) {
+            const uint32_t* source = &before[previousAt + 1 + (i - shifts[c]) * wordsPerTrailPoint];
+            uint32_t* target = &reference[at + 1 + i * wordsPerTrailPoint];
+            std::copy(source, source + wordsPerTrailPoint, target);
+            target[ageWord] = bits(value(source[ageWord]) + ageSteps[c]);
+        }
+        at += cometWords(layout.trailSizes[c]);
+        previousAt += cometWords(previousSize);
+    }
+}
+
+bool StateHistory::locate(double time, size_t& segment, size_t& frame) const {
+    if (segments.empty()) {
+        return false;
+    }
+
+    // Newest segment starting at or before time; earlier times clamp to the oldest frame
+    auto segmentIt = std::upper_bound(segments.begin(), segments.end(), time, [](double t, const Segment& s) {
+        return t < s.frames.front().simulationTime;
+    });
+    if (segmentIt == segments.begin()) {
+        segment = 0;
+        frame = 0;
+        return true;
+    }
+    --segmentIt;
+    segment = static_cast<size_t>(segmentIt - segments.begin());
+
+    const std::vector<Frame>& frames = segmentIt->frames;
+    auto frameIt = std::upper_bound(frames.begin(), frames.end(), time, [](double t, const Frame& f) {
+        return t < f.simulationTime;
+    });
+    frame = static_cast<size_t>(frameIt - frames.begin()) - 1;
+    return true;
+}
+
+void StateHistory::evictOldest() {
+    if (hasDecoded && decodedSegmentId == segments.front().id) {
+        hasDecoded = false;
+    }
+    storedBytes -= segments.front().bytes.size();
+    segments.pop_front();
+}
@@ -0,0 +1,132 @@
+#include "include/simulation/TransformHierarchy.hpp"
+#include <algorithm>
+
+using namespace glm;
+
+namespace {
+
+// Matrices are composed in fixed-size blocks. Each block gathers its nodes' yaws and scales
+// into contiguous arrays, computes sines, cosines and the rotated columns there in a loop
+// with no calls and no indexed access, which the compiler vectorizes, then scatters the
+// columns into the nodes' matrices.
+const int blockSize = 64;
+
+const float degreesToRadians = 0.017453292519943295f;
+
+// sin and cos of an angle in degrees, without libm calls so loops over it vectorize.
+// The angle is reduced to [-45, 45] degrees around a multiple of 90, which is exact in
+// float for the wrapped angles used here, then minimax polynomials (Cephes sinf/cosf,
+// within 1e-7 on that range) give both values and the quadrant swaps and negates them.
+inline void sinCosDegrees(float degrees, float& sine, float& cosine) {
+    int quadrant = static_cast<int>(degrees * (1.0f / 90.0f) + (degrees >= 0.0f ? 0.5f : -0.5f));
+    float x = (degrees - static_cast<float>(quadrant) * 90.0f) * degreesToRadians;
+    float z = x * x;
+    float s = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * x + x;
+    float c = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z -
+              0.5f * z + 1.0f;
+    bool swap = (quadrant & 1) != 0;
+    float sinePart = swap ? c : s;
+    float cosinePart = swap ? s : c;
+    sine = (quadrant & 2) != 0 ? -sinePart : sinePart;
+    cosine = ((quadrant + 1) & 2) != 0 ? -cosinePart : cosinePart;
+}
+
+}
+
+int TransformHierarchy::add(int parent) {
+    parents.push_back(parent);
+    localTranslations.push_back(vec3(0.0f));
+    yaws.push_back(0.0f);
+    scales.push_back(vec3(1.0f));
+    relative.push_back(1);
+    worldTranslations.push_back(vec3(0.0f));
+    worldMatrices.push_back(mat4(1.0f));
+    dirty.push_back(1);
+    moved.push_back(0);
+    return static_cast<int>(parents.size()) - 1;
+}
+
+void TransformHierarchy::setLocal(int index,
+                                  const vec3& translation,
+                                  float yawDegrees,
+                                  const vec3& scale,
+                                  bool isRelative) {
+    uint8_t isRelativeFlag = isRelative ? 1 : 0;
+    if (localTranslations[index] == translation && yaws[index] == yawDegrees && scales[index] == scale &&
+        relative[index] == isRelativeFlag) {
+        return;
+    }
+    localTranslations[index] = translation;
+    yaws[index] = yawDegrees;
+    scales[index] = scale;
+    relative[index] = isRelativeFlag;
+    dirty[index] = 1;
+}
+
+size_t TransformHierarchy::update() {
+    // World translations, parents first. A node is recomposed when its own transform
+    // changed or when the node it hangs off moved.
+    dirtyNodes.clear();
+    for (size_t i = 0; i < parents.size(); ++i) {
+        int parent = parents[i];
+        bool follows = parent >= 0 && relative[i];
+        bool parentMoved = follows && moved[parent];
+        moved[i] = 0;
+        if (!dirty[i] && !parentMoved) {
+            continue;
+        }
+        vec3 translation = follows ? worldTranslations[parent] + localTranslations[i] : localTranslations[i];
+        moved[i] = translation != worldTranslations[i] || parentMoved;
+        worldTranslations[i] = translation;
+        dirtyNodes.push_back(static_cast<int>(i));
+        dirty[i] = 0;
+    }
+
+    // Closed-form T * Ry * S for the dirty nodes, a block at a time
+    float blockYaws[blockSize];
+    float scaleX[blockSize];
+    float scaleZ[blockSize];
+    float column0X[blockSize];
+    float column0Z[blockSize];
+    float column2X[blockSize];
+    float column2Z[blockSize];
+    for (size_t start = 0; start < dirtyNodes.size(); start += blockSize) {
+        int count = static_cast<int>(std::min<size_t>(blockSize, dirtyNodes.size() - start));
+        const int* nodes = &dirtyNodes[start];
+
+        for (int lane = 0; lane < count; ++lane) {
+            int node = nodes[lane];
+            blockYaws[lane] = yaws[node];
+            scaleX[lane] = scales[node].x;
+            scaleZ[lane] = scales[node].z;
+        }
+        for (int lane = 0; lane < count; ++lane) {
+            float sine, cosine;
+            sinCosDegrees(blockYaws[lane], sine, cosine);
+            column0X[lane] = cosine * scaleX[lane];
+            column0Z[lane] = -sine * scaleX[lane];
+            column2X[lane] = sine * scaleZ[lane];
+            column2Z[lane] = cosine * scaleZ[lane];
+        }
+        for (int lane = 0; lane < count; ++lane) {
+            int node = nodes[lane];
+            mat4& m = worldMatrices[node];
+            m[0] = vec4(column0X[lane], 0.0f, column0Z[lane], 0.0f);
+            m[1] = vec4(0.0f, scales[node].y, 0.0f, 0.0f);
+            m[2] = vec4(column2X[lane], 0.0f, column2Z[lane], 0.0f);
+            m[3] = vec4(worldTranslations[node], 1.0f);
+        }
+    }
+    return dirtyNodes.size();
+}
+
+mat4 TransformHierarchy::compose(const vec3& translation, float yawDegrees, const vec3& scale) {
+    float c, s;
+    sinCosDegrees(yawDegrees, s, c);
+    mat4 m;
+    m[0] = vec4(c * scale.x, 0.0f, -s * scale.x, 0.0f);
+    m[1] = vec4(0.0f, scale.y, 0.0f, 0.0f);
+    m[2] = vec4(s * scale.z, 0.0f, c * scale.z, 0.0f);
+    m[3] = vec4(translation, 1.0f);
+    return m;
+}
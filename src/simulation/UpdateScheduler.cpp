@@ -0,0 +1,190 @@
+#include "include/simulation/UpdateScheduler.hpp"
+#include "include/simulation/SolarSystem.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace glm;
+
+namespace {
+const double degreesToRadians = 0.017453292519943295;
+}
+
+UpdateScheduler::UpdateScheduler()
+    : enabled(true),
+      minBodies(256),
+      fullRatePixels(4.0f),
+      maxVisiblePeriod(4),
+      offscreenPeriod(32),
+      budgetMicroseconds(1000.0),
+      focus(-1),
+      viewProjection(1.0f),
+      pixelScale(0.0f),
+      clipScale(0.0f),
+      hasView(false),
+      planAll(true),
+      frame(0),
+      cursor(0),
+      staleCount(0),
+      visibleCount(0),
+      nanosecondsPerBody(0.0) {}
+
+void UpdateScheduler::setView(const mat4& viewMatrix, const mat4& projectionMatrix, float viewportHeight) {
+    viewProjection = projectionMatrix * viewMatrix;
+    pixelScale = 0.5f * viewportHeight * std::abs(projectionMatrix[1][1]);
+    clipScale = std::max(std::abs(projectionMatrix[0][0]), std::abs(projectionMatrix[1][1]));
+    hasView = true;
+}
+
+void UpdateScheduler::plan(const SolarSystem& system, double time, std::vector<int>& due) {
+    size_t count = system.bodies.size();
+    if (posedTimes.size() != count) {
+        posedTimes.assign(count, std::numeric_limits<double>::quiet_NaN());
+        drifts.assign(count, 0.0f);
+        periods.assign(count, 1);
+        wasVisible.assign(count, 0);
+        cursor = 0;
+
+        // Bodies the rest of the frame reads: the light, what the shaders shadow with and
+        // roots that carry whole subtrees
+        pinned.clear();
+        int shadowCasters = 0;
+        for (size_t i = 0; i < count; ++i) {
+            bool isShadowCaster = !system.emissive[i] && shadowCasters < SolarSystem::maxShadowCasters;
+            shadowCasters += isShadowCaster;
+            if (isShadowCaster || system.emissive[i] || system.parents[i] < 0) {
+                pinned.push_back(static_cast<int>(i));
+            }
+        }
+    }
+    frame++;
+    due.clear();
+
+    if (!enabled || !hasView || count < minBodies || planAll) {
+        for (size_t i = 0; i < count; ++i) {
+            due.push_back(static_cast<int>(i));
+            posedTimes[i] = time;
+            wasVisible[i] = 1;
+        }
+        planAll = false;
+        staleCount = 0;
+        visibleCount = count;
+        return;
+    }
+
+    // Period from screen coverage: a sphere test against the frustum in clip space, and the
+    // projected radius for bodies on screen. Children follow their parent's position, so a
+    // parent keeps pace with its fastest child on screen. Positions and sizes come from the
+    // hierarchy's packed arrays rather than the bodies.
+    //
+    // Those positions are from each body's last evaluation, up to offscreenPeriod frames ago for
+    // a skipped one. The test sphere is widened by how far the body can have moved since: the arc
+    // its orbit swept (at most the orbit's diameter) plus its parent's drift, so a body that moved
+    // into view is caught on this frame. Ephemeris orbits have no such bound and always count.
+    const vec3* positions = system.transforms.worldTranslations.data();
+    const vec3* scales = system.transforms.scales.data();
+    const int* parents = system.parents.data();
+    bool hasEphemeris = system.ephemeris && !system.ephemerisBodies.empty();
+    visibleCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        float drift = 0.0f;
+        int parent = parents[i];
+        if (parent >= 0) {
+            if (hasEphemeris && system.ephemerisBodies[i] >= 0) {
+                drift = std::numeric_limits<float>::infinity();
+            } else if (posedTimes[i] != time) {
+                const CelestialBody& body = system.bodies[i];
+                double swept = std::abs(body.orbitSpeed * SolarSystem::orbitDegreesPerSecond *
+                                        (time - posedTimes[i])) * degreesToRadians;
+                // Never evaluated (NaN) counts as the full diameter
+                drift = std::abs(body.orbitRadius) * static_cast<float>(std::min(2.0, swept));
+            }
+            drift += drifts[parent];
+        }
+        drifts[i] = drift;
+
+        float radius = std::abs(scales[i].x);
+        float bound = radius + drift;
+        vec4 clip = viewProjection * vec4(positions[i], 1.0f);
+        float reach = bound * clipScale;
+        bool onScreen = radius > 0.01f && clip.w > -bound &&
+                        std::abs(clip.x) <= clip.w + reach && std::abs(clip.y) <= clip.w + reach &&
+                        clip.z <= clip.w + reach;
+        if (!onScreen) {
+            periods[i] = 0;
+            continue;
+        }
+        visibleCount++;
+        // Halve the rate each time the radius halves below fullRatePixels
+        int period = 1;
+        if (clip.w > radius) {
+            float pixels = radius * pixelScale / clip.w;
+            while (period < maxVisiblePeriod && pixels * period * 2 <= fullRatePixels) {
+                period *= 2;
+            }
+        }
+        periods[i] = period;
+        for (int parent = parents[i]; parent >= 0 && (periods[parent] == 0 || period < periods[parent]);
+             parent = parents[parent]) {
+            periods[parent] = period;
+        }
+    }
+    for (int index : pinned) {
+        periods[index] = 1;
+    }
+    for (int planet : system.ringPlanets) {
+        periods[planet] = 1;
+    }
+    if (focus >= 0 && focus < static_cast<int>(count)) {
+        periods[focus] = 1;
+    }
+
+    // On-screen bodies run in phase-shifted buckets so each period spreads over its frames;
+    // one that just came on screen is caught up at once
+    size_t skipped = 0;
+    size_t offscreenStale = 0;
+    for (size_t i = 0; i < count; ++i) {
+        int period = periods[i];
+        bool visible = period > 0;
+        bool cameOnScreen = visible && !wasVisible[i];
+        wasVisible[i] = visible;
+        if (posedTimes[i] == time) {
+            continue;
+        }
+        bool inPhase = ((frame + i) & static_cast<uint64_t>(period - 1)) == 0;
+        if (!visible) {
+            offscreenStale++;
+        } else if (inPhase || cameOnScreen) {
+            due.push_back(static_cast<int>(i));
+            posedTimes[i] = time;
+        } else {
+            skipped++;
+        }
+    }
+
+    // Round-robin through the off-screen bodies from where the last frame stopped
+    size_t take = (offscreenStale + offscreenPeriod - 1) / std::max(1, offscreenPeriod);
+    if (budgetMicroseconds > 0.0 && nanosecondsPerBody > 0.0) {
+        size_t affordable = static_cast<size_t>(budgetMicroseconds * 1000.0 / nanosecondsPerBody);
+        take = std::min(take, std::max<size_t>(affordable, 1));
+    }
+    size_t taken = 0;
+    for (size_t n = 0; n < count && taken < take; ++n) {
+        size_t index = cursor < count ? cursor : 0;
+        cursor = index + 1;
+        if (periods[index] == 0 && posedTimes[index] != time) {
+            due.push_back(static_cast<int>(index));
+            posedTimes[index] = time;
+            taken++;
+        }
+    }
+    staleCount = skipped + offscreenStale - taken;
+}
+
+void UpdateScheduler::finish(size_t evaluated, double microseconds) {
+    if (evaluated == 0) {
+        return;
+    }
+    double sample = microseconds * 1000.0 / evaluated;
+    nanosecondsPerBody = nanosecondsPerBody > 0.0 ? 0.9 * nanosecondsPerBody + 0.1 * sample : sample;
+}
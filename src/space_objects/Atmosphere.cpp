@@ -0,0 +1,72 @@
+#include "include/space_objects/Atmosphere.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace glm;
+
+Atmosphere Atmosphere::none() {
+    return create(vec3(0.0f), 0.0f, vec3(0.0f), 0.0f);
+}
+
+Atmosphere Atmosphere::create(const vec3& color, float thickness, const vec3& rayleigh, float mie) {
+    Atmosphere atmosphere;
+    atmosphere.color = color;
+    atmosphere.thickness = thickness;
+    atmosphere.rayleigh = rayleigh;
+    atmosphere.mie = mie;
+    return atmosphere;
+}
+
+Atmosphere Atmosphere::preset(const std::string& name) {
+    if (name == "venus") {
+        // Thick sulphuric haze, almost all Mie
+        return create(vec3(0.8f, 0.7f, 0.45f), 0.06f, vec3(0.04f, 0.04f, 0.03f), 0.15f);
+    }
+    if (name == "earth") {
+        return create(vec3(0.5f, 0.6f, 0.75f), 0.04f, vec3(0.03f, 0.07f, 0.16f), 0.01f);
+    }
+    if (name == "mars") {
+        // Thin, dusty
+        return create(vec3(0.8f, 0.45f, 0.3f), 0.02f, vec3(0.02f, 0.015f, 0.01f), 0.03f);
+    }
+    if (name == "jupiter") {
+        return create(vec3(0.7f, 0.6f, 0.5f), 0.02f, vec3(0.03f, 0.04f, 0.06f), 0.04f);
+    }
+    if (name == "saturn") {
+        return create(vec3(0.75f, 0.65f, 0.45f), 0.02f, vec3(0.03f, 0.04f, 0.05f), 0.04f);
+    }
+    if (name == "uranus") {
+        return create(vec3(0.45f, 0.7f, 0.75f), 0.03f, vec3(0.03f, 0.08f, 0.1f), 0.01f);
+    }
+    if (name == "neptune") {
+        return create(vec3(0.3f, 0.45f, 0.8f), 0.03f, vec3(0.03f, 0.06f, 0.14f), 0.01f);
+    }
+    return none();
+}
+
+vec4 Atmosphere::scattering(float mu) const {
+    if (!isPresent()) {
+        return vec4(0.0f);
+    }
+    // Path from the surface out through a shell of the given height around a unit sphere,
+    // relative to the path straight up: grows towards the limb
+    float outer = 1.0f + thickness;
+    mu = std::clamp(mu, 0.0f, 1.0f);
+    float path = (std::sqrt(mu * mu + outer * outer - 1.0f) - mu) / thickness;
+
+    vec3 extinction = rayleigh + vec3(mie);
+    vec4 result(0.0f);
+    for (int c = 0; c < 3; ++c) {
+        if (extinction[c] <= 0.0f) {
+            continue;
+        }
+        // Share of the light scattered along the path, split between the two kinds by depth
+        float scattered = 1.0f - std::exp(-extinction[c] * path);
+        result[c] = color[c] * scattered * rayleigh[c] / extinction[c];
+        result.w += scattered * mie / extinction[c] / 3.0f;
+    }
+    for (int c = 0; c < 4; ++c) {
+        result[c] = std::clamp(result[c], 0.0f, 1.0f);
+    }
+    return result;
+}
@@ -1,34 +1,38 @@
 #include "include/space_objects/Comet.hpp"
-#include <GLFW/glfw3.h>
-#include <algorithm>
+#include "include/utils/AngleUtils.hpp"
 
-Comet Comet::create(const char* texturePath,
-                    const glm::vec3& orbitCenter,
+Comet Comet::create(const glm::vec3& orbitCenter,
                     float semiMajorAxis,
                     float eccentricity) {
     Comet comet;
 
     // Create the comet head using CelestialBody factory method
-    comet.body = CelestialBody::create(texturePath, 0.05f, 0.0f, 0.0f, 10.0f);
+    comet.body = CelestialBody::create(0.05f, 0.0f, 0.0f, 10.0f);
 
     // Set up orbital parameters
     comet.orbitCenter = orbitCenter;
     comet.semiMajorAxis = semiMajorAxis;
     comet.eccentricity = eccentricity;
     comet.orbitAngle = 0.0f;
+    comet.startAngle = 0.0f;
     comet.maxTrailPoints = 150; // Long, visible trail
     comet.lastTrailUpdate = 0.0f;
-
-    // Set up trail rendering
-    glGenVertexArrays(1, &comet.trailVAO);
-    glGenBuffers(1, &comet.trailVBO);
+    comet.trailVersion = 0;
 
     return comet;
 }
 
-void Comet::update(float dt, const glm::vec3& sunPosition) {
-    // Update orbital position
-    orbitAngle += 0.5f * dt; // Slow orbital speed
+void Comet::update(double simulationTime, const glm::vec3& sunPosition, float currentTime, float elapsedSeconds) {
+    evaluate(simulationTime);
+
+    // Update trail
+    updateTrail(currentTime, elapsedSeconds, sunPosition);
+}
+
+void Comet::evaluate(double simulationTime) {
+    // Orbital position: slow orbital speed of 0.5 radians per second
+    const double twoPi = 6.283185307179586;
+    orbitAngle = static_cast<float>(AngleUtils::wrap(startAngle + 0.5 * simulationTime, twoPi));
 
     // Calculate elliptical orbit position
     float a = semiMajorAxis; // Semi-major axis
@@ -42,13 +46,12 @@ void Comet::update(float dt, const glm::vec3& sunPosition) {
     body.position = orbitCenter + glm::vec3(x, 0.0f, z);
 
     // Update rotation
-    body.rotationAngle += body.rotationSpeed * dt;
-
-    // Update trail
-    updateTrail(glfwGetTime(), sunPosition);
+    body.rotationAngle = body.rotationAt(simulationTime);
 }
 
-void Comet::updateTrail(float currentTime, const glm::vec3& sunPosition) {
+void Comet::updateTrail(float currentTime, float elapsedSeconds, const glm::vec3& sunPosition) {
+    bool changed = false;
+
     // Add new trail point every 0.1 seconds
     if (currentTime - lastTrailUpdate > 0.1f) {
         TrailPoint newPoint;
@@ -67,82 +70,19 @@ void Comet::updateTrail(float currentTime, const glm::vec3& sunPosition) {
         }
 
         lastTrailUpdate = currentTime;
+        changed = true;
     }
 
     // Age all trail points
-    for (auto& point : trail) {
-        point.age += 0.016f; // Approximate 60fps
+    if (elapsedSeconds != 0.0f && !trail.empty()) {
+        for (auto& point : trail) {
+            point.age += elapsedSeconds;
+        }
+        changed = true;
     }
 
-    updateTrailVBO();
-}
-
-void Comet::renderTrail(GLuint shader, 
-                         const glm::mat4& viewMatrix, 
-                         const glm::mat4& projectionMatrix) const {
-    if (trail.size() < 2)
-        return;
-
-    glUseProgram(shader);
-    glBindVertexArray(trailVAO);
-
-    // Set matrices
-    glm::mat4 worldMatrix(1.0f); // Identity - trail points are in world space
-    glUniformMatrix4fv(glGetUniformLocation(shader, "worldMatrix"), 1, GL_FALSE, &worldMatrix[0][0]);
-    glUniformMatrix4fv(glGetUniformLocation(shader, "viewMatrix"), 1, GL_FALSE, &viewMatrix[0][0]);
-    glUniformMatrix4fv(glGetUniformLocation(shader, "projectionMatrix"), 1, GL_FALSE, &projectionMatrix[0][0]);
-
-    // Enable blending for trail transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    // Draw trail as line strip
-    glDrawArrays(GL_LINE_STRIP, 0, trail.size());
-
-    glDisable(GL_BLEND);
-}
-
-void Comet::updateTrailVBO() {
-    if (trail.empty())
-        return;
-
-    std::vector<glm::vec3> vertices;
-    std::vector<glm::vec3> colors;
-
-    // Create line segments for the trail
-    for (size_t i = 0; i < trail.size(); ++i) {
-        vertices.push_back(trail[i].position);
-
-        // Color fades from bright blue/white to dark blue based on age
-        float fade = 1.0f - (trail[i].age / 10.0f); // Fade over 10 seconds
-        fade = std::max(0.0f, fade);
-
-        // Comet tail color - blue/white mix
-        glm::vec3 color = glm::vec3(0.7f + 0.3f * trail[i].brightness, 
-                                   0.8f + 0.2f * trail[i].brightness, 
-                                   1.0f) * fade;
-        colors.push_back(color);
+    // Snapshots and the renderer copy the trail only when this changes
+    if (changed) {
+        trailVersion++;
     }
-
-    glBindVertexArray(trailVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, trailVBO);
-    glBufferData(GL_ARRAY_BUFFER,
-                 vertices.size() * sizeof(glm::vec3) + colors.size() * sizeof(glm::vec3),
-                 nullptr,
-                 GL_DYNAMIC_DRAW);
-
-    // Upload vertices
-    glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(glm::vec3), &vertices[0]);
-
-    // Upload colors
-    glBufferSubData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), 
-                   colors.size() * sizeof(glm::vec3), &colors[0]);
-
-    // Set up vertex attributes
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, 
-                         (void*)(vertices.size() * sizeof(glm::vec3)));
-    glEnableVertexAttribArray(1);
 }
@@ -0,0 +1,8 @@
+#include "include/space_objects/StarLight.hpp"
+
+StarLight StarLight::create(const glm::vec3& color, float range) {
+    StarLight light;
+    light.color = color;
+    light.range = range;
+    return light;
+}
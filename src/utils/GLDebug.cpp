@@ -0,0 +1,108 @@
+#include "include/utils/GLDebug.hpp"
+
+#ifdef SOLARSCOPE_GL_DEBUG
+#include <cstring>
+#include <iostream>
+
+bool GLDebug::enabled = false;
+bool GLDebug::hasCallback = false;
+int GLDebug::groupDepth = 0;
+
+namespace {
+const char* sourceName(GLenum source) {
+    switch (source) {
+    case GL_DEBUG_SOURCE_API: return "api";
+    case GL_DEBUG_SOURCE_WINDOW_SYSTEM: return "window system";
+    case GL_DEBUG_SOURCE_SHADER_COMPILER: return "shader compiler";
+    case GL_DEBUG_SOURCE_THIRD_PARTY: return "third party";
+    case GL_DEBUG_SOURCE_APPLICATION: return "application";
+    default: return "other";
+    }
+}
+
+const char* typeName(GLenum type) {
+    switch (type) {
+    case GL_DEBUG_TYPE_ERROR: return "error";
+    case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "deprecated";
+    case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "undefined behavior";
+    case GL_DEBUG_TYPE_PORTABILITY: return "portability";
+    case GL_DEBUG_TYPE_PERFORMANCE: return "performance";
+    default: return "other";
+    }
+}
+
+const char* severityName(GLenum severity) {
+    switch (severity) {
+    case GL_DEBUG_SEVERITY_HIGH: return "high";
+    case GL_DEBUG_SEVERITY_MEDIUM: return "medium";
+    case GL_DEBUG_SEVERITY_LOW: return "low";
+    default: return "notification";
+    }
+}
+
+void GLAPIENTRY onMessage(GLenum source,
+                          GLenum type,
+                          GLuint id,
+                          GLenum severity,
+                          GLsizei,
+                          const GLchar* message,
+                          const void*) {
+    std::cerr << "GL " << typeName(type) << " (" << severityName(severity) << ", " << sourceName(source) << " "
+              << id << "): " << message << std::endl;
+}
+}
+
+bool GLDebug::enable() {
+    enabled = true;
+    hasCallback = GLEW_KHR_debug || GLEW_VERSION_4_3;
+    if (!hasCallback) {
+        std::cout << "GL debug: KHR_debug not supported, checking glGetError after uploads and draws instead"
+                  << std::endl;
+        return true;
+    }
+
+    GLint flags = 0;
+    glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+    if (!(flags & GL_CONTEXT_FLAG_DEBUG_BIT)) {
+        std::cout << "GL debug: not a debug context, the driver may report less" << std::endl;
+    }
+    glEnable(GL_DEBUG_OUTPUT);
+    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    glDebugMessageCallback(onMessage, nullptr);
+    // Everything but notifications, which include our own group pushes and pops
+    glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+    glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+    std::cout << "GL debug: message callback installed" << std::endl;
+    return true;
+}
+
+void GLDebug::label(GLenum identifier, GLuint name, const char* text) {
+    if (hasCallback && name != 0) {
+        glObjectLabel(identifier, name, static_cast<GLsizei>(std::strlen(text)), text);
+    }
+}
+
+void GLDebug::pushGroup(const char* name) {
+    if (hasCallback) {
+        glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name);
+        groupDepth++;
+    }
+}
+
+void GLDebug::popGroup() {
+    if (hasCallback && groupDepth > 0) {
+        glPopDebugGroup();
+        groupDepth--;
+    }
+}
+
+void GLDebug::checkErrors(const char* where) {
+    if (!enabled || hasCallback) {
+        return;
+    }
+    GLenum error;
+    while ((error = glGetError()) != GL_NO_ERROR) {
+        std::cerr << "OpenGL error in " << where << ": 0x" << std::hex << error << std::dec << std::endl;
+    }
+}
+#endif
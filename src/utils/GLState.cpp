@@ -0,0 +1,211 @@
+#include "include/utils/GLState.hpp"
+
+GLState::Counters GLState::counters = {0, 0, 0};
+
+namespace {
+const GLuint unknownName = ~0u;
+const GLenum unknownEnum = ~0u;
+const GLuint trackedTextureUnits = 16;   // Bindings on higher units always reach GL
+
+// Fixed-function capabilities the app toggles; others always reach GL
+const GLenum trackedCapabilities[] = {GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST};
+const int trackedCapabilityCount = sizeof(trackedCapabilities) / sizeof(trackedCapabilities[0]);
+
+// Last value set through GLState; unknown values never match, so the next call goes through
+struct ShadowState {
+    GLuint program;
+    GLuint vertexArray;
+    GLenum activeUnit;
+    GLuint textures2D[trackedTextureUnits];
+    GLuint texturesCube[trackedTextureUnits];
+    int capabilities[trackedCapabilityCount];   // 1 enabled, 0 disabled, -1 unknown
+    GLenum blendSource;
+    GLenum blendDestination;
+    GLenum blendSourceAlpha;
+    GLenum blendDestinationAlpha;
+    int depthMask;                               // 1 writes, 0 no writes, -1 unknown
+    GLenum depthFunc;
+    GLenum polygonMode;                          // GL_FRONT_AND_BACK only
+    GLfloat lineWidth;                           // Negative when unknown
+};
+
+ShadowState unknownShadow() {
+    ShadowState shadow;
+    shadow.program = unknownName;
+    shadow.vertexArray = unknownName;
+    shadow.activeUnit = unknownEnum;
+    for (GLuint unit = 0; unit < trackedTextureUnits; ++unit) {
+        shadow.textures2D[unit] = unknownName;
+        shadow.texturesCube[unit] = unknownName;
+    }
+    for (int i = 0; i < trackedCapabilityCount; ++i) {
+        shadow.capabilities[i] = -1;
+    }
+    shadow.blendSource = unknownEnum;
+    shadow.blendDestination = unknownEnum;
+    shadow.blendSourceAlpha = unknownEnum;
+    shadow.blendDestinationAlpha = unknownEnum;
+    shadow.depthMask = -1;
+    shadow.depthFunc = unknownEnum;
+    shadow.polygonMode = unknownEnum;
+    shadow.lineWidth = -1.0f;
+    return shadow;
+}
+
+ShadowState shadow = unknownShadow();
+
+// Record a state call: true if it has to reach GL
+bool changes(bool differs) {
+    if (differs) {
+        GLState::counters.stateChanges++;
+    } else {
+        GLState::counters.elidedChanges++;
+    }
+    return differs;
+}
+
+// Shadow binding for a texture target on the active unit, null when not tracked
+GLuint* boundTexture(GLenum target) {
+    if (shadow.activeUnit == unknownEnum || shadow.activeUnit - GL_TEXTURE0 >= trackedTextureUnits) {
+        return nullptr;
+    }
+    GLuint unit = shadow.activeUnit - GL_TEXTURE0;
+    if (target == GL_TEXTURE_2D) {
+        return &shadow.textures2D[unit];
+    }
+    if (target == GL_TEXTURE_CUBE_MAP) {
+        return &shadow.texturesCube[unit];
+    }
+    return nullptr;
+}
+
+// Update a tracked capability: true if the call has to reach GL
+bool setCapability(GLenum capability, bool enabled) {
+    for (int i = 0; i < trackedCapabilityCount; ++i) {
+        if (trackedCapabilities[i] == capability) {
+            if (!changes(shadow.capabilities[i] != static_cast<int>(enabled))) {
+                return false;
+            }
+            shadow.capabilities[i] = enabled;
+            return true;
+        }
+    }
+    return changes(true);
+}
+}
+
+void GLState::resetCounters() {
+    counters = Counters{0, 0, 0};
+}
+
+void GLState::invalidate() {
+    shadow = unknownShadow();
+}
+
+void GLState::useProgram(GLuint program) {
+    if (changes(program != shadow.program)) {
+        shadow.program = program;
+        glUseProgram(program);
+    }
+}
+
+void GLState::bindVertexArray(GLuint vao) {
+    if (changes(vao != shadow.vertexArray)) {
+        shadow.vertexArray = vao;
+        glBindVertexArray(vao);
+    }
+}
+
+void GLState::activeTexture(GLenum unit) {
+    if (changes(unit != shadow.activeUnit)) {
+        shadow.activeUnit = unit;
+        glActiveTexture(unit);
+    }
+}
+
+void GLState::bindTexture(GLenum target, GLuint texture) {
+    GLuint* bound = boundTexture(target);
+    if (changes(!bound || *bound != texture)) {
+        if (bound) {
+            *bound = texture;
+        }
+        glBindTexture(target, texture);
+    }
+}
+
+void GLState::enable(GLenum capability) {
+    if (setCapability(capability, true)) {
+        glEnable(capability);
+    }
+}
+
+void GLState::disable(GLenum capability) {
+    if (setCapability(capability, false)) {
+        glDisable(capability);
+    }
+}
+
+void GLState::blendFunc(GLenum source, GLenum destination) {
+    if (changes(source != shadow.blendSource || destination != shadow.blendDestination ||
+                source != shadow.blendSourceAlpha || destination != shadow.blendDestinationAlpha)) {
+        shadow.blendSource = source;
+        shadow.blendDestination = destination;
+        shadow.blendSourceAlpha = source;
+        shadow.blendDestinationAlpha = destination;
+        glBlendFunc(source, destination);
+    }
+}
+
+void GLState::blendFuncSeparate(GLenum sourceRGB,
+                                GLenum destinationRGB,
+                                GLenum sourceAlpha,
+                                GLenum destinationAlpha) {
+    if (changes(sourceRGB != shadow.blendSource || destinationRGB != shadow.blendDestination ||
+                sourceAlpha != shadow.blendSourceAlpha || destinationAlpha != shadow.blendDestinationAlpha)) {
+        shadow.blendSource = sourceRGB;
+        shadow.blendDestination = destinationRGB;
+        shadow.blendSourceAlpha = sourceAlpha;
+        shadow.blendDestinationAlpha = destinationAlpha;
+        glBlendFuncSeparate(sourceRGB, destinationRGB, sourceAlpha, destinationAlpha);
+    }
+}
+
+void GLState::depthMask(GLboolean write) {
+    if (changes(shadow.depthMask != static_cast<int>(write != GL_FALSE))) {
+        shadow.depthMask = write != GL_FALSE;
+        glDepthMask(write);
+    }
+}
+
+void GLState::depthFunc(GLenum func) {
+    if (changes(func != shadow.depthFunc)) {
+        shadow.depthFunc = func;
+        glDepthFunc(func);
+    }
+}
+
+void GLState::polygonMode(GLenum face, GLenum mode) {
+    // Core profile only accepts GL_FRONT_AND_BACK; anything else isn't tracked
+    bool tracked = face == GL_FRONT_AND_BACK;
+    if (changes(!tracked || mode != shadow.polygonMode)) {
+        shadow.polygonMode = tracked ? mode : unknownEnum;
+        glPolygonMode(face, mode);
+    }
+}
+
+void GLState::lineWidth(GLfloat width) {
+    if (changes(width != shadow.lineWidth)) {
+        shadow.lineWidth = width;
+        glLineWidth(width);
+    }
+}
+
+void GLState::drawArrays(GLenum mode, GLint first, GLsizei count) {
+    counters.drawCalls++;
+    glDrawArrays(mode, first, count);
+}
+
+void GLState::drawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+    counters.drawCalls++;
+    glDrawElements(mode, count, type, indices);
+}
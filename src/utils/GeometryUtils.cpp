@@ -1,4 +1,5 @@
 #include "include/utils/GeometryUtils.hpp"
+#include "include/utils/GLState.hpp"
 
 namespace GeometryUtils {
 
@@ -61,7 +62,7 @@ GLuint createVertexBufferObject() {
 
     GLuint vertexArrayObject;
     glGenVertexArrays(1, &vertexArrayObject);
-    glBindVertexArray(vertexArrayObject);
+    GLState::bindVertexArray(vertexArrayObject);
 
     GLuint vertexBufferObject;
     glGenBuffers(1, &vertexBufferObject);
@@ -0,0 +1,140 @@
+#include "include/utils/GpuProfiler.hpp"
+#include "include/utils/GLDebug.hpp"
+#include <iostream>
+
+GpuProfiler::GpuProfiler()
+    : supported(false), droppedFrames(0), lastFrameMs(0.0f), timedFrames(0), openPassCount(0), skippedDepth(0),
+      currentFrame(0), active(false) {
+    for (FrameQueries& frame : frames) {
+        frame.passCount = 0;
+        frame.queryCount = 0;
+        frame.cpuStartUs = 0.0;
+        frame.pending = false;
+        frame.profiled = false;
+    }
+}
+
+void GpuProfiler::initialize() {
+    supported = GLEW_ARB_timer_query || GLEW_VERSION_3_3;
+    if (!supported) {
+        std::cout << "GPU profiler: timer queries not supported, GPU timings disabled" << std::endl;
+        return;
+    }
+
+    for (FrameQueries& frame : frames) {
+        glGenQueries(maxPassesPerFrame * 2 + 2, frame.queries);
+    }
+}
+
+void GpuProfiler::beginFrame() {
+    currentFrame = (currentFrame + 1) % framesInFlight;
+    FrameQueries& frame = frames[currentFrame];
+
+    // The slot we are about to reuse was issued framesInFlight frames ago
+    if (frame.pending) {
+        collect(frame);
+    }
+
+    active = supported && Profiler::instance().enabled;
+    openPassCount = 0;
+    skippedDepth = 0;
+    frame.passCount = 0;
+    frame.queryCount = 2;
+    frame.profiled = active;
+    if (!supported) {
+        return;
+    }
+
+    frame.cpuStartUs = Profiler::instance().nowUs();
+    glQueryCounter(frame.queries[0], GL_TIMESTAMP);
+}
+
+void GpuProfiler::endFrame() {
+    if (!supported) {
+        return;
+    }
+    while (openPassCount > 0 || skippedDepth > 0) {
+        endPass();
+    }
+
+    FrameQueries& frame = frames[currentFrame];
+    glQueryCounter(frame.queries[1], GL_TIMESTAMP);
+    frame.pending = true;
+}
+
+void GpuProfiler::beginPass(const char* name) {
+    GLDebug::pushGroup(name);
+    FrameQueries& frame = frames[currentFrame];
+    if (!active) {
+        return;
+    }
+    // Out of queries: untimed, but its endPass must not close the enclosing pass
+    if (frame.passCount >= maxPassesPerFrame) {
+        skippedDepth++;
+        return;
+    }
+
+    Pass& pass = frame.passes[frame.passCount];
+    pass.name = name;
+    pass.depth = openPassCount;
+    pass.beginQuery = frame.queryCount++;
+    pass.endQuery = -1;
+    glQueryCounter(frame.queries[pass.beginQuery], GL_TIMESTAMP);
+
+    openPasses[openPassCount++] = frame.passCount++;
+}
+
+void GpuProfiler::endPass() {
+    GLDebug::popGroup();
+    if (!active) {
+        return;
+    }
+    if (skippedDepth > 0) {
+        skippedDepth--;
+        return;
+    }
+    if (openPassCount == 0) {
+        return;
+    }
+
+    FrameQueries& frame = frames[currentFrame];
+    Pass& pass = frame.passes[openPasses[--openPassCount]];
+    pass.endQuery = frame.queryCount++;
+    glQueryCounter(frame.queries[pass.endQuery], GL_TIMESTAMP);
+}
+
+void GpuProfiler::collect(FrameQueries& frame) {
+    frame.pending = false;
+
+    // Timestamps complete in order, so the frame-end query being ready means all are
+    GLint available = 0;
+    glGetQueryObjectiv(frame.queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+        droppedFrames++;
+        return;
+    }
+
+    GLuint64 results[maxPassesPerFrame * 2 + 2];
+    for (int i = 0; i < frame.queryCount; ++i) {
+        glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &results[i]);
+    }
+
+    lastFrameMs = static_cast<float>((results[1] - results[0]) / 1.0e6);
+    timedFrames++;
+    if (!frame.profiled) {
+        return;
+    }
+
+    Profiler& profiler = Profiler::instance();
+    profiler.addGpuFrameTime(lastFrameMs);
+
+    for (int i = 0; i < frame.passCount; ++i) {
+        const Pass& pass = frame.passes[i];
+        if (pass.endQuery < 0) {
+            continue;
+        }
+        double startUs = frame.cpuStartUs + (results[pass.beginQuery] - results[0]) / 1000.0;
+        double durationUs = (results[pass.endQuery] - results[pass.beginQuery]) / 1000.0;
+        profiler.addGpuEvent(pass.name, pass.depth, startUs, durationUs);
+    }
+}
@@ -0,0 +1,278 @@
+#include "include/utils/Profiler.hpp"
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+// Weight of the newest sample in the per-scope moving averages
+const float averageWeight = 0.05f;
+
+// Scopes opened on a thread that doesn't own the frames are kept here until they end
+struct OpenScope {
+    const char* name;
+    double startUs;
+};
+thread_local Profiler::Track threadTrack = Profiler::CPU;
+thread_local std::vector<OpenScope> threadScopes;
+
+void writeJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+    out << '"';
+}
+
+}
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+void Profiler::setThreadTrack(Track track) {
+    threadTrack = track;
+}
+
+Profiler::Profiler()
+    : enabled(true),
+      origin(std::chrono::steady_clock::now()),
+      historyHead(0),
+      gpuHistoryHead(0),
+      frameStartUs(0.0),
+      frameCount(0),
+      frameEnabled(true),
+      gpuResultsArrived(false),
+      capturing(false) {
+    for (int i = 0; i < historySize; ++i) {
+        cpuHistory[i] = 0.0f;
+        gpuHistory[i] = -1.0f;
+    }
+}
+
+double Profiler::nowUs() const {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - origin).count();
+}
+
+void Profiler::beginFrame() {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    frameEvents.clear();
+    openScopes.clear();
+    frameEnabled = enabled;
+    frameStartUs = nowUs();
+}
+
+void Profiler::endFrame() {
+    std::lock_guard<std::mutex> lock(dataMutex);
+
+    // Close anything left open so a missing endScope cannot corrupt the next frame
+    while (!openScopes.empty()) {
+        closeScope();
+    }
+
+    double frameEndUs = nowUs();
+    cpuHistory[historyHead] = static_cast<float>((frameEndUs - frameStartUs) / 1000.0);
+    historyHead = (historyHead + 1) % historySize;
+
+    for (const Event& event : frameEvents) {
+        statsFor(event.name, event.track, event.depth).pendingMs += static_cast<float>(event.durationUs / 1000.0);
+    }
+
+    for (ScopeStats& scope : stats) {
+        if (scope.track == GPU && !gpuResultsArrived) {
+            continue;
+        }
+        scope.lastMs = scope.pendingMs;
+        scope.averageMs = scope.averageMs + averageWeight * (scope.lastMs - scope.averageMs);
+        scope.pendingMs = 0.0f;
+    }
+
+    if (capturing) {
+        recordEvent(Event{"Frame", CPU, -1, frameStartUs, frameEndUs - frameStartUs});
+        for (const Event& event : frameEvents) {
+            recordEvent(event);
+        }
+    }
+
+    previousFrameEvents.swap(frameEvents);
+    gpuResultsArrived = false;
+    frameCount++;
+}
+
+void Profiler::beginScope(const char* name) {
+    if (threadTrack != CPU) {
+        threadScopes.push_back(OpenScope{name, nowUs()});
+        return;
+    }
+    std::lock_guard<std::mutex> lock(dataMutex);
+    if (!frameEnabled) {
+        return;
+    }
+    openScopes.push_back(static_cast<int>(frameEvents.size()));
+    frameEvents.push_back(Event{name, CPU, static_cast<int>(openScopes.size()) - 1, nowUs(), 0.0});
+}
+
+void Profiler::endScope() {
+    if (threadTrack != CPU) {
+        if (threadScopes.empty()) {
+            return;
+        }
+        OpenScope scope = threadScopes.back();
+        threadScopes.pop_back();
+        Event event{scope.name, threadTrack, static_cast<int>(threadScopes.size()), scope.startUs,
+                    nowUs() - scope.startUs};
+        std::lock_guard<std::mutex> lock(dataMutex);
+        if (frameEnabled) {
+            frameEvents.push_back(event);
+        }
+        return;
+    }
+    std::lock_guard<std::mutex> lock(dataMutex);
+    closeScope();
+}
+
+void Profiler::closeScope() {
+    if (openScopes.empty()) {
+        return;
+    }
+    Event& event = frameEvents[openScopes.back()];
+    event.durationUs = nowUs() - event.startUs;
+    openScopes.pop_back();
+}
+
+void Profiler::addGpuEvent(const char* name, int depth, double startUs, double durationUs) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    Event event{name, GPU, depth, startUs, durationUs};
+    statsFor(name, GPU, depth).pendingMs += static_cast<float>(durationUs / 1000.0);
+    if (capturing) {
+        recordEvent(event);
+    }
+}
+
+void Profiler::addGpuFrameTime(float ms) {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    gpuHistory[gpuHistoryHead] = ms;
+    gpuHistoryHead = (gpuHistoryHead + 1) % historySize;
+    gpuResultsArrived = true;
+}
+
+void Profiler::startCapture() {
+    std::lock_guard<std::mutex> lock(dataMutex);
+    capturedEvents.clear();
+    capturing = true;
+    std::cout << "Profiler: trace capture started" << std::endl;
+}
+
+bool Profiler::stopCapture(const std::string& path) {
+    // Take the events and write them without holding the lock, so the render thread keeps going
+    std::vector<Event> events;
+    {
+        std::lock_guard<std::mutex> lock(dataMutex);
+        if (!capturing) {
+            return false;
+        }
+        capturing = false;
+        events.swap(capturedEvents);
+    }
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Profiler: failed to open trace file: " << path << std::endl;
+        return false;
+    }
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}},\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":3,\"args\":{\"name\":\"Render thread\"}}";
+
+    for (const Event& event : events) {
+        file << ",\n{\"name\":";
+        writeJsonString(file, event.name);
+        file << ",\"cat\":\"" << (event.track == GPU ? "gpu" : "cpu") << "\",\"ph\":\"X\""
+             << ",\"pid\":1,\"tid\":" << event.track + 1
+             << ",\"ts\":" << event.startUs << ",\"dur\":" << event.durationUs << "}";
+    }
+    file << "\n]}\n";
+
+    std::cout << "Profiler: wrote " << events.size() << " events to " << path << std::endl;
+    return true;
+}
+
+float Profiler::cpuFrameMs(int index) const {
+    return cpuHistory[(historyHead + index) % historySize];
+}
+
+float Profiler::gpuFrameMs(int index) const {
+    return gpuHistory[(gpuHistoryHead + index) % historySize];
+}
+
+float Profiler::averageCpuFrameMs() const {
+    int frames = frameCount < historySize ? static_cast<int>(frameCount) : historySize;
+    if (frames == 0) {
+        return 0.0f;
+    }
+    float total = 0.0f;
+    for (int i = historySize - frames; i < historySize; ++i) {
+        total += cpuFrameMs(i);
+    }
+    return total / frames;
+}
+
+float Profiler::averageGpuFrameMs() const {
+    float total = 0.0f;
+    int frames = 0;
+    for (int i = 0; i < historySize; ++i) {
+        if (gpuHistory[i] >= 0.0f) {
+            total += gpuHistory[i];
+            frames++;
+        }
+    }
+    return frames > 0 ? total / frames : -1.0f;
+}
+
+void Profiler::printSummary(std::ostream& out) const {
+    out << std::fixed << std::setprecision(2);
+    out << "---- Profiler (" << historySize << " frame window) ----" << std::endl;
+    out << "Frame CPU: " << averageCpuFrameMs() << " ms";
+    float gpuMs = averageGpuFrameMs();
+    if (gpuMs >= 0.0f) {
+        out << "  GPU: " << gpuMs << " ms";
+    }
+    out << std::endl;
+
+    const char* prefixes[] = {"[cpu] ", "[gpu] ", "[render] "};
+    for (int track = CPU; track <= RENDER; ++track) {
+        for (const ScopeStats& scope : stats) {
+            if (scope.track != track) {
+                continue;
+            }
+            out << prefixes[track] << std::string(scope.depth * 2, ' ') << scope.name << ": "
+                << scope.averageMs << " ms" << std::endl;
+        }
+    }
+    out << std::defaultfloat;
+}
+
+void Profiler::recordEvent(const Event& event) {
+    if (capturedEvents.size() >= maxCapturedEvents) {
+        return;
+    }
+    capturedEvents.push_back(event);
+}
+
+Profiler::ScopeStats& Profiler::statsFor(const char* name, int track, int depth) {
+    for (ScopeStats& scope : stats) {
+        if (scope.track == track && scope.depth == depth && std::strcmp(scope.name, name) == 0) {
+            return scope;
+        }
+    }
+    stats.push_back(ScopeStats{name, track, depth, 0.0f, 0.0f, 0.0f});
+    return stats.back();
+}
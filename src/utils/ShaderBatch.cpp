@@ -0,0 +1,128 @@
+#include "include/utils/ShaderBatch.hpp"
+#include "include/utils/GLDebug.hpp"
+#include "include/utils/ShaderCache.hpp"
+#include "include/utils/ShaderUtils.hpp"
+#include <cctype>
+#include <iostream>
+#include <vector>
+
+namespace {
+std::string upperCase(std::string text) {
+    for (char& c : text) {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    return text;
+}
+
+// Full info log of a shader or program, however long the driver made it
+std::string infoLog(GLuint object, bool isProgram) {
+    GLint length = 0;
+    if (isProgram) {
+        glGetProgramiv(object, GL_INFO_LOG_LENGTH, &length);
+    } else {
+        glGetShaderiv(object, GL_INFO_LOG_LENGTH, &length);
+    }
+    if (length <= 1) {
+        return "";
+    }
+    std::vector<char> log(length);
+    if (isProgram) {
+        glGetProgramInfoLog(object, length, nullptr, log.data());
+    } else {
+        glGetShaderInfoLog(object, length, nullptr, log.data());
+    }
+    return std::string(log.data());
+}
+
+GLuint submitShader(GLenum type, const std::string& source) {
+    GLuint shader = glCreateShader(type);
+    const char* text = source.c_str();
+    glShaderSource(shader, 1, &text, nullptr);
+    glCompileShader(shader);
+    return shader;
+}
+
+bool compiled(GLuint shader, const std::string& name, const char* stage) {
+    GLint success = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        std::cerr << "ERROR::SHADER::" << upperCase(name) << "::" << stage << "::COMPILATION_FAILED\n"
+                  << infoLog(shader, false) << std::endl;
+    }
+    return success;
+}
+}
+
+ShaderBatch::ShaderBatch(ShaderCache& shaderCache) : cache(shaderCache), parallel(false) {
+    // Let the driver pick how many compiler threads to use
+    if (GLEW_KHR_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsKHR(0xffffffff);
+        parallel = true;
+    } else if (GLEW_ARB_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsARB(0xffffffff);
+        parallel = true;
+    }
+}
+
+GLuint ShaderBatch::add(const std::string& name,
+                        const char* vertexPath,
+                        const char* fragmentPath,
+                        const std::string& defines) {
+    Entry entry;
+    entry.name = name;
+    entry.vertexSource = ShaderUtils::withDefines(ShaderUtils::readFile(vertexPath), defines);
+    entry.fragmentSource = ShaderUtils::withDefines(ShaderUtils::readFile(fragmentPath), defines);
+    entry.vertexShader = 0;
+    entry.fragmentShader = 0;
+
+    entry.program = cache.load(name, entry.vertexSource, entry.fragmentSource);
+    if (!entry.program) {
+        // Compile and link are only queued here; nothing asks for a result until finish()
+        entry.vertexShader = submitShader(GL_VERTEX_SHADER, entry.vertexSource);
+        entry.fragmentShader = submitShader(GL_FRAGMENT_SHADER, entry.fragmentSource);
+        entry.program = glCreateProgram();
+        glAttachShader(entry.program, entry.vertexShader);
+        glAttachShader(entry.program, entry.fragmentShader);
+        cache.prepareLink(entry.program);
+        glLinkProgram(entry.program);
+    }
+    GLDebug::label(GL_PROGRAM, entry.program, name.c_str());
+    entries.push_back(entry);
+    return entry.program;
+}
+
+bool ShaderBatch::finish() {
+    bool allLinked = true;
+    for (Entry& entry : entries) {
+        if (!entry.vertexShader) {
+            continue;
+        }
+        bool ok = compiled(entry.vertexShader, entry.name, "VERTEX");
+        ok = compiled(entry.fragmentShader, entry.name, "FRAGMENT") && ok;
+
+        GLint linked = GL_FALSE;
+        glGetProgramiv(entry.program, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            std::cerr << "ERROR::SHADER::" << upperCase(entry.name) << "::PROGRAM::LINKING_FAILED\n"
+                      << infoLog(entry.program, true) << std::endl;
+        }
+        if (ok && linked) {
+            cache.store(entry.name, entry.vertexSource, entry.fragmentSource, entry.program);
+        }
+        allLinked = allLinked && ok && linked;
+
+        glDetachShader(entry.program, entry.vertexShader);
+        glDetachShader(entry.program, entry.fragmentShader);
+        glDeleteShader(entry.vertexShader);
+        glDeleteShader(entry.fragmentShader);
+        entry.vertexShader = 0;
+        entry.fragmentShader = 0;
+    }
+    entries.clear();
+
+    if (cache.isOpen()) {
+        std::cout << "Shader cache: " << cache.hits << " of " << cache.hits + cache.misses
+                  << " programs loaded from binaries" << std::endl;
+    }
+    return allLinked;
+}
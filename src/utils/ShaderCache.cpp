@@ -0,0 +1,165 @@
+#include "include/utils/ShaderCache.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+#include <vector>
+
+namespace {
+const char fileMagic[4] = {'S', 'S', 'P', 'B'};
+const uint32_t fileVersion = 1;
+const uint32_t maxBinaryLength = 64u << 20;   // Larger lengths mean a corrupt file
+
+// Fixed-size header in front of the driver's binary
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    uint32_t binaryFormat;
+    uint32_t binaryLength;
+};
+
+// FNV-1a, continuing from hash
+uint64_t fnv1a(uint64_t hash, const std::string& text) {
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    // Separator, so "ab" + "c" and "a" + "bc" hash differently
+    hash ^= 0xff;
+    hash *= 1099511628211ull;
+    return hash;
+}
+
+std::string glString(GLenum name) {
+    const GLubyte* value = glGetString(name);
+    return value ? reinterpret_cast<const char*>(value) : "";
+}
+}
+
+ShaderCache::ShaderCache() : hits(0), misses(0), enabled(false) {}
+
+bool ShaderCache::open(const std::string& cacheDirectory) {
+    enabled = false;
+    directory = cacheDirectory;
+
+    GLint formats = 0;
+    if (GLEW_ARB_get_program_binary) {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    }
+    if (formats <= 0) {
+        std::cout << "Shader cache: program binaries not supported, compiling from source" << std::endl;
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "Shader cache: failed to create " << directory << ": " << error.message() << std::endl;
+        return false;
+    }
+
+    driver = glString(GL_VENDOR) + '\n' + glString(GL_RENDERER) + '\n' + glString(GL_VERSION);
+    enabled = true;
+    return true;
+}
+
+uint64_t ShaderCache::key(const std::string& vertexSource, const std::string& fragmentSource) const {
+    uint64_t hash = 14695981039346656037ull;
+    hash = fnv1a(hash, driver);
+    hash = fnv1a(hash, vertexSource);
+    return fnv1a(hash, fragmentSource);
+}
+
+std::string ShaderCache::path(const std::string& name) const {
+    return (std::filesystem::path(directory) / (name + ".bin")).string();
+}
+
+void ShaderCache::prepareLink(GLuint program) const {
+    if (enabled) {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+}
+
+GLuint ShaderCache::load(const std::string& name, const std::string& vertexSource, const std::string& fragmentSource) {
+    if (!enabled) {
+        misses++;
+        return 0;
+    }
+
+    std::ifstream file(path(name), std::ios::binary);
+    FileHeader header;
+    if (!file.is_open() || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0 || header.version != fileVersion ||
+        header.key != key(vertexSource, fragmentSource) || header.binaryLength > maxBinaryLength) {
+        misses++;
+        return 0;
+    }
+    std::vector<char> binary(header.binaryLength);
+    if (!file.read(binary.data(), binary.size())) {
+        misses++;
+        return 0;
+    }
+
+    // The driver may still refuse a binary with a matching key, e.g. after a partial update
+    GLuint program = glCreateProgram();
+    prepareLink(program);
+    glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        glDeleteProgram(program);
+        misses++;
+        return 0;
+    }
+    hits++;
+    return program;
+}
+
+void ShaderCache::store(const std::string& name,
+                        const std::string& vertexSource,
+                        const std::string& fragmentSource,
+                        GLuint program) const {
+    if (!enabled) {
+        return;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+    std::vector<char> binary(length);
+    GLenum binaryFormat = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &binaryFormat, binary.data());
+    if (written <= 0) {
+        return;
+    }
+
+    FileHeader header;
+    std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+    header.version = fileVersion;
+    header.key = key(vertexSource, fragmentSource);
+    header.binaryFormat = binaryFormat;
+    header.binaryLength = static_cast<uint32_t>(written);
+
+    // Write next to the entry and rename, so a crash never leaves a torn file behind
+    std::string target = path(name);
+    std::string temporary = target + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), written);
+        if (!file) {
+            std::cerr << "Shader cache: failed to write " << temporary << std::endl;
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, target, error);
+    if (error) {
+        std::cerr << "Shader cache: failed to write " << target << ": " << error.message() << std::endl;
+    }
+}
@@ -1,4 +1,6 @@
 #include "include/utils/ShaderUtils.hpp"
+#include "include/utils/GLState.hpp"
+#include "include/utils/ShaderBatch.hpp"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -14,219 +16,65 @@ std::string ShaderUtils::readFile(const char* filePath) {
     return buffer.str();
 }
 
-// Basic shader sources
-std::string ShaderUtils::getVertexShaderSource() {
-    return readFile("shaders/shader.vert.glsl");
-}
-
-std::string ShaderUtils::getFragmentShaderSource() {
-    return readFile("shaders/shader.frag.glsl");
-}
-
-// Selection shader sources
-std::string ShaderUtils::getSelectionVertexShaderSource() {
-    return readFile("shaders/selection.vert.glsl");
-}
-
-std::string ShaderUtils::getSelectionFragmentShaderSource() {
-    return readFile("shaders/selection.frag.glsl");
-}
-
-// Skybox shader sources
-std::string ShaderUtils::getSkyboxVertexShaderSource() {
-    return readFile("shaders/skybox_vertex.glsl");
-}
-
-std::string ShaderUtils::getSkyboxFragmentShaderSource() {
-    return readFile("shaders/skybox_fragment.glsl");
-}
-
-// Textured sphere shader sources
-std::string ShaderUtils::getTexturedSphereVertexShaderSource() {
-    return readFile("shaders/textured_sphere.vert.glsl");
-}
-
-std::string ShaderUtils::getTexturedSphereFragmentShaderSource() {
-    return readFile("shaders/textured_sphere.frag.glsl");
-}
-
-// UI shader sources
-std::string ShaderUtils::getUIVertexShaderSource() {
-    return readFile("shaders/ui.vert.glsl");
-}
-
-std::string ShaderUtils::getUIFragmentShaderSource() {
-    return readFile("shaders/ui.frag.glsl");
-}
-
-// Shader compilation methods
-int ShaderUtils::compileVertexAndFragShaders() {
-    int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    std::string vertexShaderSourceStr = getVertexShaderSource();
-    const char* vertexShaderSource = vertexShaderSourceStr.c_str();
-    glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-    glCompileShader(vertexShader);
-
-    int success;
-    char infoLog[512];
-    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-        std::cerr << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
+std::string ShaderUtils::withDefines(const std::string& source, const std::string& defines) {
+    if (defines.empty()) {
+        return source;
     }
-
-    int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    std::string fragmentShaderSourceStr = getFragmentShaderSource();
-    const char* fragmentShaderSource = fragmentShaderSourceStr.c_str();
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-    glCompileShader(fragmentShader);
-
-    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-        std::cerr << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
+    // #version has to stay the first statement, so the defines go on the line after it
+    size_t insertAt = 0;
+    if (source.compare(0, 8, "#version") == 0) {
+        size_t lineEnd = source.find('\n');
+        insertAt = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
     }
-
-    int shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-        std::cerr << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+    std::string result = source.substr(0, insertAt);
+    if (insertAt == source.size() && !result.empty() && result.back() != '\n') {
+        result += '\n';
     }
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    return shaderProgram;
+    return result + defines + source.substr(insertAt);
 }
 
-unsigned int ShaderUtils::compileSkyboxShaderProgram() {
-    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    std::string vertexShaderStr = getSkyboxVertexShaderSource();
-    const char* vertexShaderSource = vertexShaderStr.c_str();
-    glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
-    glCompileShader(vertexShader);
-
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    std::string fragmentShaderStr = getSkyboxFragmentShaderSource();
-    const char* fragmentShaderSource = fragmentShaderStr.c_str();
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, nullptr);
-    glCompileShader(fragmentShader);
-
-    GLuint program = glCreateProgram();
-    glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
-    glLinkProgram(program);
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    return program;
-}
-
-GLuint ShaderUtils::compileTexturedSphereShader() {
-    GLuint vs = glCreateShader(GL_VERTEX_SHADER);
-    std::string vsSourceStr = getTexturedSphereVertexShaderSource();
-    const char* vsSource = vsSourceStr.c_str();
-    glShaderSource(vs, 1, &vsSource, nullptr);
-    glCompileShader(vs);
-
-    GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
-    std::string fsSourceStr = getTexturedSphereFragmentShaderSource();
-    const char* fsSource = fsSourceStr.c_str();
-    glShaderSource(fs, 1, &fsSource, nullptr);
-    glCompileShader(fs);
-
-    GLuint program = glCreateProgram();
-    glAttachShader(program, vs);
-    glAttachShader(program, fs);
-    glLinkProgram(program);
-    glDeleteShader(vs);
-    glDeleteShader(fs);
-    return program;
-}
-
-GLuint ShaderUtils::compileUIShader() {
-    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    std::string vertexShaderStr = getUIVertexShaderSource();
-    const char* vertexShaderSource = vertexShaderStr.c_str();
-    glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
-    glCompileShader(vertexShader);
-
-    int success;
-    char infoLog[512];
-    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(vertexShader, 512, nullptr, infoLog);
-        std::cerr << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
-    }
-
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    std::string fragmentShaderStr = getUIFragmentShaderSource();
-    const char* fragmentShaderSource = fragmentShaderStr.c_str();
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, nullptr);
-    glCompileShader(fragmentShader);
-
-    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(fragmentShader, 512, nullptr, infoLog);
-        std::cerr << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
-    }
-
-    GLuint program = glCreateProgram();
-    glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
-    glLinkProgram(program);
-
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(program, 512, nullptr, infoLog);
-        std::cerr << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+ShaderPrograms ShaderUtils::beginShaderPrograms(ShaderBatch& batch) {
+    ShaderPrograms shaders;
+    shaders.base = batch.add("base", "shaders/shader.vert.glsl", "shaders/shader.frag.glsl");
+    shaders.skybox = batch.add("skybox", "shaders/skybox_vertex.glsl", "shaders/skybox_fragment.glsl");
+
+    // One program per sphere material, each compiled with only the code it runs
+    const struct {
+        SphereVariant variant;
+        const char* name;
+        const char* defines;
+    } sphereVariants[] = {
+        {SphereVariant::Sun, "sphere_sun", "#define SUN\n"},
+        {SphereVariant::Planet, "sphere_planet", "#define ATMOSPHERE\n"},
+        {SphereVariant::PlanetShadowed, "sphere_planet_shadowed", "#define ATMOSPHERE\n#define SHADOWS\n"},
+        {SphereVariant::Airless, "sphere_airless", ""},
+        {SphereVariant::AirlessShadowed, "sphere_airless_shadowed", "#define SHADOWS\n"},
+        {SphereVariant::Ring, "sphere_ring", "#define OIT\n"},
+    };
+    for (const auto& permutation : sphereVariants) {
+        shaders.sphere[static_cast<size_t>(permutation.variant)] =
+            batch.add(permutation.name, "shaders/textured_sphere.vert.glsl", "shaders/textured_sphere.frag.glsl",
+                      permutation.defines);
     }
 
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    shaders.ui = batch.add("ui", "shaders/ui.vert.glsl", "shaders/ui.frag.glsl");
+    shaders.hud = batch.add("hud", "shaders/hud.vert.glsl", "shaders/hud.frag.glsl");
+    shaders.trail = batch.add("trail", "shaders/trail.vert.glsl", "shaders/trail.frag.glsl");
+    shaders.oitComposite =
+        batch.add("oit_composite", "shaders/oit_composite.vert.glsl", "shaders/oit_composite.frag.glsl");
 
-    return program;
+    // Selection indicator shader
+    shaders.selection = batch.add("selection", "shaders/selection.vert.glsl", "shaders/selection.frag.glsl");
+    return shaders;
 }
 
-ShaderPrograms ShaderUtils::setupShaderPrograms() {
-    ShaderPrograms shaders;
-
-    shaders.base = compileVertexAndFragShaders();
-    glUseProgram(shaders.base);
+void ShaderUtils::finishShaderPrograms(ShaderBatch& batch, const ShaderPrograms& shaders) {
+    batch.finish();
 
-    shaders.skybox = compileSkyboxShaderProgram();
-    glUseProgram(shaders.skybox);
+    GLState::useProgram(shaders.skybox);
     glUniform1i(glGetUniformLocation(shaders.skybox, "skybox"), 0);
-
-    shaders.orb = compileTexturedSphereShader();
-    shaders.ui = compileUIShader();
-
-    // Compile selection indicator shader
-    int selectionVertexShader = glCreateShader(GL_VERTEX_SHADER);
-    std::string selectionVertexSource = getSelectionVertexShaderSource();
-    const char* selectionVertexSourcePtr = selectionVertexSource.c_str();
-    glShaderSource(selectionVertexShader, 1, &selectionVertexSourcePtr, NULL);
-    glCompileShader(selectionVertexShader);
-
-    int selectionFragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    std::string selectionFragmentSource = getSelectionFragmentShaderSource();
-    const char* selectionFragmentSourcePtr = selectionFragmentSource.c_str();
-    glShaderSource(selectionFragmentShader, 1, &selectionFragmentSourcePtr, NULL);
-    glCompileShader(selectionFragmentShader);
-
-    shaders.selection = glCreateProgram();
-    glAttachShader(shaders.selection, selectionVertexShader);
-    glAttachShader(shaders.selection, selectionFragmentShader);
-    glLinkProgram(shaders.selection);
-
-    glDeleteShader(selectionVertexShader);
-    glDeleteShader(selectionFragmentShader);
-
-    return shaders;
+    GLState::useProgram(shaders.oitComposite);
+    glUniform1i(glGetUniformLocation(shaders.oitComposite, "accumulation"), 0);
+    glUniform1i(glGetUniformLocation(shaders.oitComposite, "weight"), 1);
+    GLState::useProgram(shaders.base);
 }
@@ -43,44 +43,3 @@ void SphereUtils::generateSphereIndices(unsigned int rings,
         }
     }
 }
-
-GLuint SphereUtils::setupSphereBuffers(const std::vector<glm::vec3>& vertices,
-                                        const std::vector<glm::vec2>& uvs,
-                                        const std::vector<unsigned int>& indices) {
-    GLuint vao, vbo[2], ebo;
-    glGenVertexArrays(1, &vao);
-    glBindVertexArray(vao);
-
-    glGenBuffers(2, vbo);
-
-    glBindBuffer(GL_ARRAY_BUFFER, vbo[0]);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), &vertices[0], GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glBindBuffer(GL_ARRAY_BUFFER, vbo[1]);
-    glBufferData(GL_ARRAY_BUFFER, uvs.size() * sizeof(glm::vec2), &uvs[0], GL_STATIC_DRAW);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
-    glEnableVertexAttribArray(1);
-
-    glGenBuffers(1, &ebo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
-
-    return vao;
-}
-
-GLuint SphereUtils::createTexturedSphereVAO(unsigned int rings,
-                                              unsigned int sectors,
-                                              unsigned int& indexCount) {
-    std::vector<glm::vec3> vertices;
-    std::vector<glm::vec2> uvs;
-    std::vector<unsigned int> indices;
-
-    generateSphereVerticesAndUVs(rings, sectors, vertices, uvs);
-    generateSphereIndices(rings, sectors, indices);
-
-    indexCount = indices.size();
-    return setupSphereBuffers(vertices, uvs, indices);
-}
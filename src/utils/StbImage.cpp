@@ -0,0 +1,3 @@
+// Single translation unit holding the stb_image implementation
+#define STB_IMAGE_IMPLEMENTATION
+#include "include/stb_image.h"
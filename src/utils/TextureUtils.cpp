@@ -1,4 +1,6 @@
 #include "include/utils/TextureUtils.hpp"
+#include "include/utils/GLDebug.hpp"
+#include "include/utils/GLState.hpp"
 #include "stb_image.h"
 
 GLuint TextureUtils::loadTexture(const char* path) {
@@ -14,7 +16,7 @@ GLuint TextureUtils::loadTexture(const char* path) {
                   << " channels: " << nrChannels << std::endl;
 
         GLenum format = (nrChannels == 4) ? GL_RGBA : GL_RGB;
-        glBindTexture(GL_TEXTURE_2D, textureID);
+        GLState::bindTexture(GL_TEXTURE_2D, textureID);
         glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
         glGenerateMipmap(GL_TEXTURE_2D);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -22,11 +24,8 @@ GLuint TextureUtils::loadTexture(const char* path) {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-        // Check for OpenGL errors
-        GLenum err;
-        while ((err = glGetError()) != GL_NO_ERROR) {
-            std::cerr << "OpenGL error in loadTexture: " << err << std::endl;
-        }
+        GLDebug::label(GL_TEXTURE, textureID, path);
+        GLDebug::checkErrors("loadTexture");
 
         stbi_image_free(data);
     } else {
@@ -0,0 +1,67 @@
+#include "include/utils/WorkerPool.hpp"
+#include <algorithm>
+
+WorkerPool::WorkerPool(size_t threadCount) {
+    threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&WorkerPool::workerLoop, this, i + 1);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::run(size_t count, const std::function<void(size_t)>& work) {
+    count = std::min(count, size());
+    if (count == 0) {
+        return;
+    }
+    if (count > 1) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &work;
+            jobCount = count;
+            remaining = count - 1;
+            generation++;
+        }
+        wake.notify_all();
+    }
+
+    work(0);
+
+    if (count > 1) {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this] { return remaining == 0; });
+        job = nullptr;
+    }
+}
+
+void WorkerPool::workerLoop(size_t worker) {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping) {
+            return;
+        }
+        seen = generation;
+        if (worker >= jobCount) {
+            continue;
+        }
+        const std::function<void(size_t)>* work = job;
+        lock.unlock();
+        (*work)(worker);
+        lock.lock();
+        if (--remaining == 0) {
+            finished.notify_one();
+        }
+    }
+}
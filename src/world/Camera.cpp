@@ -1,6 +1,5 @@
 #include "include/space_objects/CelestialBody.hpp"
 #include "include/world/Camera.hpp"
-#include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <algorithm>
@@ -38,29 +37,28 @@ void Camera::updateAngles(float dx, float dy, float dt) {
     lookAt = vec3(cos(phi) * cos(theta), sin(phi), -cos(phi) * sin(theta));
 }
 
-void Camera::updatePosition(GLFWwindow* window, float dt) {
-    bool fastCam = glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS || 
-                   glfwGetKey(window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS;
+void Camera::updatePosition(const FrameInput& input, float dt) {
+    bool fastCam = input.isDown(Key::LeftShift) || input.isDown(Key::RightShift);
 
     float currentCameraSpeed = fastCam ? fastSpeed : speed;
     vec3 cameraSideVector = cross(lookAt, up);
 
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) {
+    if (input.isDown(Key::W)) {
         position += lookAt * dt * currentCameraSpeed;
     }
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) {
+    if (input.isDown(Key::S)) {
         position -= lookAt * dt * currentCameraSpeed;
     }
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) {
+    if (input.isDown(Key::A)) {
         position -= cameraSideVector * dt * currentCameraSpeed;
     }
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) {
+    if (input.isDown(Key::D)) {
         position += cameraSideVector * dt * currentCameraSpeed;
     }
-    if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS) {
+    if (input.isDown(Key::Q)) {
         position += up * dt * currentCameraSpeed;
     }
-    if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS) {
+    if (input.isDown(Key::E)) {
         position -= up * dt * currentCameraSpeed;
     }
 }
@@ -1,9 +1,10 @@
 #include "include/world/InfoPanel.hpp"
+#include "include/utils/GLState.hpp"
 #include "include/utils/TextureUtils.hpp"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
-InfoPanel::InfoPanel() : visible(false), wasIPressed(false), fadeAlpha(0.0f), currentTexture(0) {}
+InfoPanel::InfoPanel() : visible(false), fadeAlpha(0.0f), currentTexture(0) {}
 
 void InfoPanel::loadPlanetTextures() {
     planetNames = {
@@ -63,11 +64,11 @@ void InfoPanel::hide() {
 
 void InfoPanel::renderBackground(GLuint shader, int windowWidth, int windowHeight) const {
     // Enable blending for transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_DEPTH_TEST); // Render on top of everything
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::disable(GL_DEPTH_TEST); // Render on top of everything
 
-    glUseProgram(shader);
+    GLState::useProgram(shader);
 
     // Set up orthographic projection for 2D overlay
     glm::mat4 orthoProjection = glm::ortho(0.0f, (float)windowWidth, 0.0f, (float)windowHeight, -1.0f, 1.0f);
@@ -103,7 +104,7 @@ void InfoPanel::renderBackground(GLuint shader, int windowWidth, int windowHeigh
         glGenBuffers(1, &EBO);
     }
 
-    glBindVertexArray(VAO);
+    GLState::bindVertexArray(VAO);
 
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
@@ -128,10 +129,10 @@ void InfoPanel::renderBackground(GLuint shader, int windowWidth, int windowHeigh
     glUniform1f(glGetUniformLocation(shader, "alpha"), fadeAlpha * 0.8f); // Semi-transparent
 
     // Draw the quad
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    GLState::drawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 
-    glEnable(GL_DEPTH_TEST);
-    glDisable(GL_BLEND);
+    GLState::enable(GL_DEPTH_TEST);
+    GLState::disable(GL_BLEND);
 }
 
 void InfoPanel::renderOnScreen(GLuint uiShader, int windowWidth, int windowHeight) const {
@@ -145,11 +146,11 @@ void InfoPanel::renderOnScreen(GLuint uiShader, int windowWidth, int windowHeigh
     }
 
     // Enable blending for transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_DEPTH_TEST);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::disable(GL_DEPTH_TEST);
 
-    glUseProgram(uiShader);
+    GLState::useProgram(uiShader);
 
     // Set up orthographic projection for 2D overlay
     glm::mat4 orthoProjection = glm::ortho(0.0f, (float)windowWidth, 0.0f, (float)windowHeight);
@@ -184,7 +185,7 @@ void InfoPanel::renderOnScreen(GLuint uiShader, int windowWidth, int windowHeigh
         glGenBuffers(1, &EBO);
     }
 
-    glBindVertexArray(VAO);
+    GLState::bindVertexArray(VAO);
 
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
@@ -201,8 +202,8 @@ void InfoPanel::renderOnScreen(GLuint uiShader, int windowWidth, int windowHeigh
     glEnableVertexAttribArray(1);
 
     // Bind the planet info texture
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, currentTexture);
+    GLState::activeTexture(GL_TEXTURE0);
+    GLState::bindTexture(GL_TEXTURE_2D, currentTexture);
     glUniform1i(glGetUniformLocation(uiShader, "ourTexture"), 0);
 
     // Set projection matrix and alpha
@@ -210,10 +211,10 @@ void InfoPanel::renderOnScreen(GLuint uiShader, int windowWidth, int windowHeigh
     glUniform1f(glGetUniformLocation(uiShader, "alpha"), fadeAlpha);
 
     // Draw the textured quad
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    GLState::drawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 
-    glEnable(GL_DEPTH_TEST);
-    glDisable(GL_BLEND);
+    GLState::enable(GL_DEPTH_TEST);
+    GLState::disable(GL_BLEND);
 }
 
 void InfoPanel::toggle(const PlanetInfo& info) {
@@ -232,13 +233,9 @@ void InfoPanel::update(float dt) {
     }
 }
 
-void InfoPanel::handleInput(GLFWwindow* window, const PlanetInfo& currentPlanetInfo) {
-    bool iPressed = glfwGetKey(window, GLFW_KEY_I) == GLFW_PRESS;
-
-    if (iPressed && !wasIPressed) {
+void InfoPanel::handleInput(const FrameInput& input, const PlanetInfo& currentPlanetInfo) {
+    if (input.pressed(Key::I)) {
         toggle(currentPlanetInfo);
         std::cout << (visible ? "Planet info shown on screen" : "Planet info hidden") << std::endl;
     }
-
-    wasIPressed = iPressed;
 }
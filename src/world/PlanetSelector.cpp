@@ -1,9 +1,6 @@
 #include "include/world/PlanetSelector.hpp"
-#include <glm/gtc/matrix_transform.hpp>
 
-using namespace glm;
-
-PlanetSelector::PlanetSelector() : selectedIndex(0), was3Pressed(false) {}
+PlanetSelector::PlanetSelector() : selectedIndex(0) {}
 
 PlanetSelector PlanetSelector::setupWithInfo(std::vector<CelestialBody*>& allBodies) {
     PlanetSelector planetSelector;
@@ -101,36 +98,6 @@ PlanetSelector PlanetSelector::setupWithInfo(std::vector<CelestialBody*>& allBod
     return planetSelector;
 }
 
-void PlanetSelector::renderSelectionIndicator(GLuint shader,
-                                            const mat4& viewMatrix,
-                                            const mat4& projectionMatrix) const {
-    CelestialBody* selectedBody = celestialBodies[selectedIndex];
-    if (!selectedBody) return;
-
-    glUseProgram(shader);
-    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE); // Wireframe mode
-    glLineWidth(3.0f);                         // Thick lines
-
-    // Create a slightly larger sphere around the selected planet
-    float indicatorScale = selectedBody->scale.x * 1.5f;
-    mat4 worldMatrix = translate(mat4(1.0f), selectedBody->position) * scale(mat4(1.0f), vec3(indicatorScale));
-
-    glUniformMatrix4fv(glGetUniformLocation(shader, "worldMatrix"), 1, GL_FALSE, &worldMatrix[0][0]);
-    glUniformMatrix4fv(glGetUniformLocation(shader, "viewMatrix"), 1, GL_FALSE, &viewMatrix[0][0]);
-    glUniformMatrix4fv(glGetUniformLocation(shader, "projectionMatrix"), 1, GL_FALSE, &projectionMatrix[0][0]);
-
-    // Set white color for the selection indicator
-    vec3 selectionColor = vec3(1.0f, 1.0f, 1.0f); // White
-    glUniform3fv(glGetUniformLocation(shader, "selectionColor"), 1, &selectionColor[0]);
-
-    // Render the wireframe sphere
-    glBindVertexArray(selectedBody->vao);
-    glDrawElements(GL_TRIANGLES, selectedBody->indexCount, GL_UNSIGNED_INT, 0);
-
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL); // Back to solid mode
-    glLineWidth(1.0f);                         // Reset line width
-}
-
 void PlanetSelector::addCelestialBody(CelestialBody* body, const std::string& name, const PlanetInfo& info) {
     celestialBodies.push_back(body);
     celestialNames.push_back(name);
@@ -138,6 +105,9 @@ void PlanetSelector::addCelestialBody(CelestialBody* body, const std::string& na
 }
 
 void PlanetSelector::nextSelection() {
+    if (celestialBodies.empty()) {
+        return;
+    }
     selectedIndex = (selectedIndex + 1) % celestialBodies.size();
     std::cout << "Selected: " << celestialNames[selectedIndex] << std::endl;
 }
@@ -0,0 +1,184 @@
+#include "include/world/ProfilerOverlay.hpp"
+#include "include/utils/GLState.hpp"
+#include "include/utils/Profiler.hpp"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+
+namespace {
+
+const int paletteSize = 8;
+const float palette[paletteSize][4] = {
+    {0.90f, 0.30f, 0.30f, 0.9f}, // red
+    {0.30f, 0.60f, 0.95f, 0.9f}, // blue
+    {0.95f, 0.85f, 0.30f, 0.9f}, // yellow
+    {0.65f, 0.40f, 0.90f, 0.9f}, // purple
+    {0.30f, 0.85f, 0.80f, 0.9f}, // cyan
+    {0.95f, 0.55f, 0.80f, 0.9f}, // pink
+    {0.60f, 0.80f, 0.35f, 0.9f}, // lime
+    {0.85f, 0.85f, 0.85f, 0.9f}, // grey
+};
+const char* paletteNames[paletteSize] = {"red", "blue", "yellow", "purple", "cyan", "pink", "lime", "grey"};
+
+const float backgroundColor[4] = {0.05f, 0.05f, 0.12f, 0.75f};
+const float gridColor[4] = {0.5f, 0.5f, 0.5f, 0.5f};
+const float cpuColor[4] = {0.3f, 0.95f, 0.4f, 1.0f};
+const float gpuColor[4] = {1.0f, 0.6f, 0.2f, 1.0f};
+
+// Panel layout in pixels
+const float panelMargin = 20.0f;
+const float panelWidth = 360.0f;
+const float panelHeight = 150.0f;
+const float padding = 10.0f;
+const float barHeight = 6.0f;
+const float graphMaxMs = 50.0f;  // Top of the frame time graph
+const float barMaxMs = 33.3f;    // Full bar width
+
+}
+
+ProfilerOverlay::ProfilerOverlay() : visible(false), vao(0), vbo(0) {}
+
+void ProfilerOverlay::initialize() {
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+
+    GLState::bindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+    // Position attribute
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // Color attribute
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    GLState::bindVertexArray(0);
+}
+
+void ProfilerOverlay::toggle() {
+    visible = !visible;
+    std::cout << "Profiler overlay " << (visible ? "shown" : "hidden") << std::endl;
+    if (visible) {
+        printLegend();
+    }
+}
+
+void ProfilerOverlay::addQuad(float x, float y, float width, float height, const float* color) {
+    const float corners[6][2] = {
+        {x, y}, {x + width, y}, {x + width, y + height},
+        {x + width, y + height}, {x, y + height}, {x, y}
+    };
+    for (const auto& corner : corners) {
+        vertices.insert(vertices.end(), {corner[0], corner[1], color[0], color[1], color[2], color[3]});
+    }
+}
+
+void ProfilerOverlay::addLine(float x0, float y0, float x1, float y1, const float* color) {
+    vertices.insert(vertices.end(), {x0, y0, color[0], color[1], color[2], color[3]});
+    vertices.insert(vertices.end(), {x1, y1, color[0], color[1], color[2], color[3]});
+}
+
+void ProfilerOverlay::render(GLuint hudShader, int windowWidth, int windowHeight) {
+    if (!visible) {
+        return;
+    }
+
+    const Profiler& profiler = Profiler::instance();
+    std::unique_lock<std::mutex> lock(profiler.mutex());
+    vertices.clear();
+
+    float graphX = panelMargin + padding;
+    float graphY = panelMargin + padding * 2.0f + barHeight * 2.0f;
+    float graphWidth = panelWidth - padding * 2.0f;
+    float graphHeight = panelHeight - (graphY - panelMargin) - padding;
+
+    // Triangles: background and per-scope bars
+    addQuad(panelMargin, panelMargin, panelWidth, panelHeight, backgroundColor);
+
+    float barWidthPerMs = graphWidth / barMaxMs;
+    float cpuBarX = graphX;
+    float gpuBarX = graphX;
+    int colorIndex = 0;
+    for (const Profiler::ScopeStats& scope : profiler.scopeStats()) {
+        const float* color = palette[colorIndex++ % paletteSize];
+        if (scope.depth != 0) {
+            continue;
+        }
+        if (scope.track == Profiler::CPU) {
+            float width = std::min(scope.lastMs * barWidthPerMs, graphX + graphWidth - cpuBarX);
+            addQuad(cpuBarX, panelMargin + padding + barHeight + 2.0f, width, barHeight, color);
+            cpuBarX += width;
+        } else if (scope.track == Profiler::GPU) {
+            float width = std::min(scope.lastMs * barWidthPerMs, graphX + graphWidth - gpuBarX);
+            addQuad(gpuBarX, panelMargin + padding, width, barHeight, color);
+            gpuBarX += width;
+        }
+    }
+    size_t triangleVertexCount = vertices.size() / 6;
+
+    // Lines: reference lines and frame time graphs
+    for (float ms : {16.7f, 33.3f}) {
+        float y = graphY + ms / graphMaxMs * graphHeight;
+        addLine(graphX, y, graphX + graphWidth, y, gridColor);
+    }
+
+    float step = graphWidth / (Profiler::historySize - 1);
+    for (int i = 1; i < Profiler::historySize; ++i) {
+        float x0 = graphX + (i - 1) * step;
+        float x1 = graphX + i * step;
+
+        float cpu0 = std::min(profiler.cpuFrameMs(i - 1), graphMaxMs);
+        float cpu1 = std::min(profiler.cpuFrameMs(i), graphMaxMs);
+        addLine(x0, graphY + cpu0 / graphMaxMs * graphHeight, x1, graphY + cpu1 / graphMaxMs * graphHeight, cpuColor);
+
+        float gpu0 = profiler.gpuFrameMs(i - 1);
+        float gpu1 = profiler.gpuFrameMs(i);
+        if (gpu0 >= 0.0f && gpu1 >= 0.0f) {
+            gpu0 = std::min(gpu0, graphMaxMs);
+            gpu1 = std::min(gpu1, graphMaxMs);
+            addLine(x0, graphY + gpu0 / graphMaxMs * graphHeight, x1, graphY + gpu1 / graphMaxMs * graphHeight, gpuColor);
+        }
+    }
+    size_t lineVertexCount = vertices.size() / 6 - triangleVertexCount;
+    lock.unlock();
+
+    // Enable blending for the translucent panel
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::disable(GL_DEPTH_TEST);
+
+    GLState::useProgram(hudShader);
+    glm::mat4 orthoProjection = glm::ortho(0.0f, (float)windowWidth, 0.0f, (float)windowHeight);
+    glUniformMatrix4fv(glGetUniformLocation(hudShader, "projection"), 1, GL_FALSE, &orthoProjection[0][0]);
+
+    GLState::bindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STREAM_DRAW);
+
+    GLState::drawArrays(GL_TRIANGLES, 0, triangleVertexCount);
+    GLState::drawArrays(GL_LINES, triangleVertexCount, lineVertexCount);
+
+    GLState::bindVertexArray(0);
+    GLState::enable(GL_DEPTH_TEST);
+    GLState::disable(GL_BLEND);
+}
+
+void ProfilerOverlay::printLegend() const {
+    const Profiler& profiler = Profiler::instance();
+    std::lock_guard<std::mutex> lock(profiler.mutex());
+    profiler.printSummary(std::cout);
+
+    std::cout << "Overlay: green line = CPU frame, orange line = GPU frame, grid at 16.7/33.3 ms" << std::endl;
+    std::cout << "Bars (upper = CPU scopes, lower = GPU passes):" << std::endl;
+    int colorIndex = 0;
+    for (const Profiler::ScopeStats& scope : profiler.scopeStats()) {
+        const char* colorName = paletteNames[colorIndex++ % paletteSize];
+        if (scope.depth == 0 && scope.track != Profiler::RENDER) {
+            std::cout << "  " << colorName << " = " << scope.name << (scope.track == Profiler::GPU ? " (gpu)" : "")
+                      << std::endl;
+        }
+    }
+}
@@ -0,0 +1,294 @@
+#include "include/world/SceneController.hpp"
+#include "include/utils/Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <utility>
+
+using namespace glm;
+
+namespace {
+
+void hashBytes(uint64_t& hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+void hashVec3(uint64_t& hash, const vec3& v) {
+    hashBytes(hash, &v.x, sizeof(float));
+    hashBytes(hash, &v.y, sizeof(float));
+    hashBytes(hash, &v.z, sizeof(float));
+}
+
+}
+
+SceneController::SceneController(SolarSystem system)
+    : solarSystem(std::move(system)),
+      planetSelectionMode(false),
+      isPaused(false),
+      timeSpeed(1.0f),
+      projectionMatrix(glm::perspective(70.0f, 800.0f / 600.0f, 0.01f, 100.0f)),
+      viewportHeight(600.0f),
+      frameCount(0),
+      lastStepDt(0.0f),
+      historyCursor(0.0),
+      reviewingHistory(false),
+      lastCursorX(0.0),
+      lastCursorY(0.0),
+      hasCursor(false) {
+    // Setup planet selector with detailed information
+    std::vector<CelestialBody*> allBodies;
+    for (const char* name : {"sun", "mercury", "mars", "venus", "earth", "moon", "neptune", "uranus", "saturn", "jupiter"}) {
+        int index = solarSystem.findBody(name);
+        if (index < 0) {
+            return;
+        }
+        allBodies.push_back(&solarSystem.bodies[index]);
+    }
+    planetSelector = PlanetSelector::setupWithInfo(allBodies);
+}
+
+void SceneController::update(const FrameInput& input) {
+    handleInput(input);
+    updateSimulation(input);
+    updateCamera(input);
+}
+
+void SceneController::handleInput(const FrameInput& input) {
+    // Handle pause input
+    if (input.pressed(Key::Space)) {
+        isPaused = !isPaused;
+    }
+
+    // Time speed controls
+    if (input.pressed(Key::Equal) || input.pressed(Key::KeypadAdd)) {
+        timeSpeed *= 1.5f; // Increase speed by 50%
+        if (timeSpeed > 10.0f)
+            timeSpeed = 10.0f; // Cap at 10x speed
+        std::cout << "Time speed: " << timeSpeed << "x" << std::endl;
+    }
+
+    if (input.pressed(Key::Minus) || input.pressed(Key::KeypadSubtract)) {
+        timeSpeed /= 1.5f; // Decrease speed
+        if (timeSpeed < -10.0f)
+            timeSpeed = -10.0f; // Cap reverse speed
+        std::cout << "Time speed: " << timeSpeed << "x" << std::endl;
+    }
+
+    if (input.pressed(Key::Num9)) {
+        timeSpeed *= -1.0f; // Reverse time direction
+        std::cout << "Time " << (timeSpeed < 0 ? "reversed" : "forward") << " at " << std::abs(timeSpeed)
+                  << "x speed" << std::endl;
+    }
+
+    // Reset to normal speed
+    if (input.isDown(Key::Num0)) {
+        timeSpeed = 1.0f;
+        std::cout << "Time speed reset to normal" << std::endl;
+    }
+
+    // Changing the scene while reviewing the past continues from there
+    if (reviewingHistory && (input.pressed(Key::C) || input.pressed(Key::X) || input.pressed(Key::R))) {
+        leaveHistory();
+    }
+
+    // Planet size comparison mode
+    if (input.pressed(Key::C)) {
+        solarSystem.comparisonMode = !solarSystem.comparisonMode;
+        if (solarSystem.comparisonMode) {
+            std::cout << "Planet size comparison mode ON - Press C again to return to orbit mode" << std::endl;
+        } else {
+            std::cout << "Returned to normal orbit mode" << std::endl;
+        }
+    }
+
+    // Handle planet selection with key 3
+    if (input.pressed(Key::Num3)) {
+        if (!planetSelectionMode) {
+            // Enter planet selection mode
+            planetSelectionMode = true;
+            camera.firstPerson = false; // Switch to third person for better planet viewing
+            std::cout << "Entered planet selection mode. Press 'I' to show planet info. Selected: "
+                      << planetSelector.getSelectedName() << std::endl;
+        } else {
+            // Cycle to next planet
+            planetSelector.nextSelection();
+            std::cout << "Selected: " << planetSelector.getSelectedName() << " (Press 'I' for info)" << std::endl;
+        }
+    }
+
+    // Exit planet selection mode with key 4
+    if (input.isDown(Key::Num4) && planetSelectionMode) {
+        planetSelectionMode = false;
+        std::cout << "Exited planet selection mode" << std::endl;
+    }
+
+    // X key to activate black hole
+    if (input.pressed(Key::X) && !solarSystem.blackHole.active) {
+        solarSystem.activateBlackHole(clockTime());
+        std::cout << "Black hole activated!" << std::endl;
+    }
+
+    // R key to reset
+    if (input.pressed(Key::R)) {
+        solarSystem.resetBlackHole();
+        std::cout << "Black hole reset!" << std::endl;
+    }
+
+    // Only allow manual camera mode switching when not in planet selection mode
+    if (!planetSelectionMode) {
+        if (input.isDown(Key::Num1)) {
+            camera.firstPerson = true;
+        }
+        if (input.isDown(Key::Num2)) {
+            camera.firstPerson = false;
+        }
+    }
+}
+
+void SceneController::updateSimulation(const FrameInput& input) {
+    float dt = animationDt(input);
+    clock.beginFrame(input.dt);
+    frameCount++;
+
+    // Simulation LOD from the camera as last drawn; the followed planet always updates
+    UpdateScheduler& scheduler = solarSystem.scheduler;
+    scheduler.setView(camera.updateViewMatrix(), projectionMatrix, viewportHeight);
+    CelestialBody* selected = planetSelectionMode ? planetSelector.getSelectedBody() : nullptr;
+    scheduler.focus = selected ? static_cast<int>(selected - solarSystem.bodies.data()) : -1;
+    if (updateFromHistory(input, dt)) {
+        // Keep clock time running so wall-clock timers continue where playback leaves off
+        while (clock.step()) {
+        }
+        return;
+    }
+
+    int steps = 0;
+    {
+        PROFILE_SCOPE("Simulation");
+        float stepDt = isPaused ? 0.0f : static_cast<float>(clock.stepSeconds) * timeSpeed;
+        while (clock.step()) {
+            solarSystem.step(stepDt, clockTime(), static_cast<float>(clock.stepSeconds));
+            lastStepDt = stepDt;
+            steps++;
+        }
+    }
+    {
+        PROFILE_SCOPE("Pose bodies");
+        float behind = 1.0f - clock.alpha();
+        solarSystem.poseBodies(solarSystem.simulationTime - behind * lastStepDt,
+                               clockTime() - behind * static_cast<float>(clock.stepSeconds));
+    }
+    // Only frames that moved time forward; paused steps would fill the budget with copies of one moment
+    if (steps > 0 && lastStepDt > 0.0f) {
+        PROFILE_SCOPE("History");
+        history.record(solarSystem, clockTime());
+    }
+}
+
+bool SceneController::updateFromHistory(const FrameInput& input, float dt) {
+    int scrub = static_cast<int>(input.isDown(Key::RightBracket)) - static_cast<int>(input.isDown(Key::LeftBracket));
+    bool reversing = dt < 0.0f;
+    if (history.empty() || (!reviewingHistory && scrub == 0 && !reversing)) {
+        return false;
+    }
+    if (!reviewingHistory) {
+        reviewingHistory = true;
+        historyCursor = history.newestTime();
+    }
+
+    if (scrub != 0) {
+        historyCursor += scrub * scrubSecondsPerSecond * std::max(1.0f, std::abs(timeSpeed)) * input.dt;
+    } else if (reversing) {
+        historyCursor += dt;
+        if (historyCursor < history.oldestTime()) {
+            // Out of recorded frames: from the oldest one the orbits keep reversing analytically
+            PROFILE_SCOPE("History restore");
+            history.restore(history.oldestTime(), solarSystem, clockTime());
+            history.clear();
+            reviewingHistory = false;
+            return false;
+        }
+    } else if (dt > 0.0f) {
+        leaveHistory();
+        return false;
+    }
+
+    // Paused while reviewing holds the frame
+    PROFILE_SCOPE("History restore");
+    historyCursor = std::clamp(historyCursor, history.oldestTime(), history.newestTime());
+    history.restore(historyCursor, solarSystem, clockTime());
+    return true;
+}
+
+void SceneController::leaveHistory() {
+    history.discardAfterRestored();
+    reviewingHistory = false;
+}
+
+void SceneController::updateCamera(const FrameInput& input) {
+    PROFILE_SCOPE("Camera input");
+    float dt = input.dt;
+
+    if (!hasCursor) {
+        lastCursorX = input.cursorX;
+        lastCursorY = input.cursorY;
+        hasCursor = true;
+    }
+
+    // Update camera for planet selection mode
+    if (planetSelectionMode) {
+        camera.updateForSelectedPlanet(planetSelector.getSelectedBody(), dt);
+        return;
+    }
+
+    // Update camera from mouse input (only when not in planet selection mode)
+    double dx = input.cursorX - lastCursorX;
+    double dy = input.cursorY - lastCursorY;
+    lastCursorX = input.cursorX;
+    lastCursorY = input.cursorY;
+
+    camera.updateAngles(static_cast<float>(dx), static_cast<float>(dy), dt);
+    camera.updatePosition(input, dt);
+
+    // Handle arrow key camera control
+    const float arrowLookSpeed = 60.0f;
+    if (input.isDown(Key::Left)) {
+        camera.horizontalAngle += arrowLookSpeed * dt;
+    }
+    if (input.isDown(Key::Right)) {
+        camera.horizontalAngle -= arrowLookSpeed * dt;
+    }
+    if (input.isDown(Key::Up)) {
+        camera.verticalAngle += arrowLookSpeed * dt;
+    }
+    if (input.isDown(Key::Down)) {
+        camera.verticalAngle -= arrowLookSpeed * dt;
+    }
+
+    // Update camera look direction based on angles
+    float theta = radians(camera.horizontalAngle);
+    float phi = radians(camera.verticalAngle);
+    camera.lookAt = vec3(cos(phi) * cos(theta), sin(phi), -cos(phi) * sin(theta));
+}
+
+uint64_t SceneController::stateChecksum() const {
+    uint64_t hash = 14695981039346656037ull;
+    for (const CelestialBody& body : solarSystem.bodies) {
+        hashVec3(hash, body.position);
+        hashVec3(hash, body.scale);
+        hashBytes(hash, &body.rotationAngle, sizeof(body.rotationAngle));
+    }
+    for (const Comet& comet : solarSystem.comets) {
+        hashVec3(hash, comet.body.position);
+        size_t trailSize = comet.trail.size();
+        hashBytes(hash, &trailSize, sizeof(trailSize));
+    }
+    hashVec3(hash, camera.position);
+    hashVec3(hash, camera.lookAt);
+    hashBytes(hash, &solarSystem.simulationTime, sizeof(solarSystem.simulationTime));
+    return hash;
+}
@@ -0,0 +1,46 @@
+#include "include/world/SceneSnapshot.hpp"
+#include "include/world/SceneController.hpp"
+
+void SceneSnapshot::capture(SceneController& scene) {
+    const SolarSystem& system = scene.solarSystem;
+    frame = scene.frameCount;
+    clockTime = scene.clock.time() - (1.0 - scene.clock.alpha()) * scene.clock.stepSeconds;
+
+    bodyMatrices = system.transforms.worldMatrices;
+    visibleBodies.clear();
+    for (size_t i = 0; i < system.bodies.size(); ++i) {
+        if (system.isVisible(static_cast<int>(i))) {
+            visibleBodies.push_back(static_cast<int>(i));
+        }
+    }
+
+    ringMatrices.resize(system.rings.size());
+    for (size_t r = 0; r < system.rings.size(); ++r) {
+        ringMatrices[r] = system.rings[r].getWorldMatrix(system.bodies[system.ringPlanets[r]]);
+    }
+
+    comets.resize(system.comets.size());
+    for (size_t i = 0; i < system.comets.size(); ++i) {
+        const Comet& comet = system.comets[i];
+        CometView& view = comets[i];
+        view.headMatrix = comet.body.getWorldMatrix();
+        if (!view.hasTrail || view.trailVersion != comet.trailVersion) {
+            view.trail = comet.trail;
+            view.trailVersion = comet.trailVersion;
+            view.hasTrail = true;
+        }
+    }
+
+    system.collectShadowCasters(shadowPositions, shadowRadii);
+    system.collectLights(lightPositions, lights);
+
+    viewMatrix = scene.camera.updateViewMatrix();
+    cameraPosition = scene.camera.position;
+    firstPerson = scene.camera.firstPerson;
+    planetSelectionMode = scene.planetSelectionMode;
+    const CelestialBody* selected = scene.planetSelector.getSelectedBody();
+    hasSelection = planetSelectionMode && selected != nullptr;
+    if (hasSelection) {
+        selectedBody = *selected;
+    }
+}
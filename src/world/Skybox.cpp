@@ -1,4 +1,5 @@
 #include "include/world/Skybox.hpp"
+#include "include/utils/GLState.hpp"
 #include <glm/gtc/type_ptr.hpp>
 #include <stb_image.h>
 #include <iostream>
@@ -59,7 +60,7 @@ Skybox Skybox::create(const std::vector<std::string>& faces) {
     glGenVertexArrays(1, &skybox.vao);
     glGenBuffers(1, &skybox.vbo);
 
-    glBindVertexArray(skybox.vao);
+    GLState::bindVertexArray(skybox.vao);
     glBindBuffer(GL_ARRAY_BUFFER, skybox.vbo);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), &vertices, GL_STATIC_DRAW);
 
@@ -74,7 +75,7 @@ Skybox Skybox::create(const std::vector<std::string>& faces) {
 unsigned int Skybox::loadCubemap(const std::vector<std::string>& faces) {
     unsigned int textureID;
     glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+    GLState::bindTexture(GL_TEXTURE_CUBE_MAP, textureID);
 
     int width, height, nrChannels;
     for (unsigned int i = 0; i < faces.size(); i++) {
@@ -106,8 +107,8 @@ unsigned int Skybox::loadCubemap(const std::vector<std::string>& faces) {
 }
 
 void Skybox::render(GLuint shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) const {
-    glDepthFunc(GL_LEQUAL);
-    glUseProgram(shader);
+    GLState::depthFunc(GL_LEQUAL);
+    GLState::useProgram(shader);
 
     // Remove translation from view matrix for skybox
     glm::mat4 skyboxView = glm::mat4(glm::mat3(viewMatrix));
@@ -115,9 +116,9 @@ void Skybox::render(GLuint shader, const glm::mat4& viewMatrix, const glm::mat4&
     glUniformMatrix4fv(glGetUniformLocation(shader, "view"), 1, GL_FALSE, glm::value_ptr(skyboxView));
     glUniformMatrix4fv(glGetUniformLocation(shader, "projection"), 1, GL_FALSE, glm::value_ptr(projectionMatrix));
 
-    glBindVertexArray(vao);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    GLState::bindVertexArray(vao);
+    GLState::bindTexture(GL_TEXTURE_CUBE_MAP, texture);
+    GLState::drawArrays(GL_TRIANGLES, 0, 36);
 
-    glDepthFunc(GL_LESS);
+    GLState::depthFunc(GL_LESS);
 }
@@ -1,6 +1,6 @@
 #include "include/world/Window.hpp"
 
-GLFWwindow* Window::initializeGLFW() {
+GLFWwindow* Window::initializeGLFW(bool debugContext) {
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW" << std::endl;
         return nullptr;
@@ -10,6 +10,7 @@ GLFWwindow* Window::initializeGLFW() {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 2);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, debugContext ? GLFW_TRUE : GLFW_FALSE);
 
     GLFWwindow* window = glfwCreateWindow(800, 600, "Comp371 - Project Assignment", NULL, NULL);
 
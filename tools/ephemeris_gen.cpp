@@ -0,0 +1,223 @@
+// Writes a Chebyshev ephemeris table for the app's --ephemeris option:
+//
+//     ./solarscope_ephemgen --start 1950-01-01 --end 2050-01-01 --out solar.ephem
+//     ./solarscope --ephemeris solar.ephem --date 2024-04-08
+//
+// Planets are fitted to the Keplerian elements of Standish, "Approximate Positions of the
+// Planets" (JPL, table for 1800-2050 AD, arcminute accuracy); the Moon to its mean orbital
+// elements. A table converted from a JPL DE file has the same layout and drops in unchanged.
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "include/simulation/Ephemeris.hpp"
+
+namespace {
+
+const double pi = 3.14159265358979323846;
+const double j2000 = 2451545.0;
+
+struct Elements {
+    double a, e, inclination, meanLongitude, perihelion, node;  // AU and degrees at J2000
+};
+
+struct Planet {
+    const char* name;
+    Elements value;
+    Elements ratePerCentury;
+    double granuleDays;
+    unsigned int coefficientCount;
+};
+
+// Earth uses the Earth-Moon barycenter; the difference is far below display resolution
+const Planet planets[] = {
+    {"mercury",
+     {0.38709927, 0.20563593, 7.00497902, 252.25032350, 77.45779628, 48.33076593},
+     {0.00000037, 0.00001906, -0.00594749, 149472.67411175, 0.16047689, -0.12534081},
+     16.0, 14},
+    {"venus",
+     {0.72333566, 0.00677672, 3.39467605, 181.97909950, 131.60246718, 76.67984255},
+     {0.00000390, -0.00004107, -0.00078890, 58517.81538729, 0.00268329, -0.27769418},
+     32.0, 12},
+    {"earth",
+     {1.00000261, 0.01671123, -0.00001531, 100.46457166, 102.93768193, 0.0},
+     {0.00000562, -0.00004392, -0.01294668, 35999.37244981, 0.32327364, 0.0},
+     32.0, 12},
+    {"mars",
+     {1.52371034, 0.09339410, 1.84969142, -4.55343205, -23.94362959, 49.55953891},
+     {0.00001847, 0.00007882, -0.00813131, 19140.30268499, 0.44441088, -0.29257343},
+     64.0, 12},
+    {"jupiter",
+     {5.20288700, 0.04838624, 1.30439695, 34.39644051, 14.72847983, 100.47390909},
+     {-0.00011607, -0.00013253, -0.00183714, 3034.74612775, 0.21252668, 0.20469106},
+     256.0, 10},
+    {"saturn",
+     {9.53667594, 0.05386179, 2.48599187, 49.95424423, 92.59887831, 113.66242448},
+     {-0.00125060, -0.00050991, 0.00193609, 1222.49362201, -0.41897216, -0.28867794},
+     256.0, 10},
+    {"uranus",
+     {19.18916464, 0.04725744, 0.77263783, 313.23810451, 170.95427630, 74.01692503},
+     {-0.00196176, -0.00004397, -0.00242939, 428.48202785, 0.40805281, 0.04240589},
+     512.0, 10},
+    {"neptune",
+     {30.06992276, 0.00859048, 1.77004347, -55.12002969, 44.96476227, 131.78422574},
+     {0.00026291, 0.00005105, 0.00035372, 218.45945325, -0.32241464, -0.00508664},
+     512.0, 10},
+};
+
+double radians(double degrees) {
+    return degrees * pi / 180.0;
+}
+
+// Heliocentric (or geocentric, for the Moon) ecliptic position of an elliptical orbit
+glm::dvec3 orbitPosition(double a, double e, double inclination, double perihelionArgument, double node,
+                         double meanAnomaly) {
+    double m = std::remainder(radians(meanAnomaly), 2.0 * pi);
+    double eccentricAnomaly = m + e * std::sin(m);
+    for (int i = 0; i < 8; ++i) {
+        eccentricAnomaly -= (eccentricAnomaly - e * std::sin(eccentricAnomaly) - m) /
+                            (1.0 - e * std::cos(eccentricAnomaly));
+    }
+    double x = a * (std::cos(eccentricAnomaly) - e);
+    double y = a * std::sqrt(1.0 - e * e) * std::sin(eccentricAnomaly);
+
+    double cw = std::cos(radians(perihelionArgument)), sw = std::sin(radians(perihelionArgument));
+    double cn = std::cos(radians(node)), sn = std::sin(radians(node));
+    double ci = std::cos(radians(inclination)), si = std::sin(radians(inclination));
+    return glm::dvec3((cw * cn - sw * sn * ci) * x + (-sw * cn - cw * sn * ci) * y,
+                      (cw * sn + sw * cn * ci) * x + (-sw * sn + cw * cn * ci) * y,
+                      (sw * si) * x + (cw * si) * y);
+}
+
+glm::dvec3 planetPosition(const Planet& planet, double jd) {
+    double t = (jd - j2000) / 36525.0;
+    const Elements& v = planet.value;
+    const Elements& r = planet.ratePerCentury;
+    double perihelion = v.perihelion + r.perihelion * t;
+    double node = v.node + r.node * t;
+    return orbitPosition(v.a + r.a * t,
+                         v.e + r.e * t,
+                         v.inclination + r.inclination * t,
+                         perihelion - node,
+                         node,
+                         v.meanLongitude + r.meanLongitude * t - perihelion);
+}
+
+// Mean lunar elements, relative to the Earth (Schlyter, "Computing planetary positions")
+glm::dvec3 moonPosition(double jd) {
+    double d = jd - 2451543.5;
+    const double earthRadiiPerAu = 1.0 / 23454.8;
+    return orbitPosition(60.2666 * earthRadiiPerAu,
+                         0.0549,
+                         5.1454,
+                         318.0634 + 0.1643573223 * d,
+                         125.1228 - 0.0529538083 * d,
+                         115.3654 + 13.0649929509 * d);
+}
+
+// Chebyshev interpolation at the Chebyshev nodes of each granule; c0 is stored halved so the
+// reader sums the series directly
+template <typename Function>
+Ephemeris::BodyTable fit(const std::string& name, int center, double granuleDays, unsigned int count,
+                         double startJd, double endJd, Function position) {
+    Ephemeris::BodyTable table;
+    table.body.name = name;
+    table.body.center = center;
+    table.body.coefficientCount = count;
+    table.body.granuleDays = granuleDays;
+    table.body.granuleCount = static_cast<uint32_t>(std::ceil((endJd - startJd) / granuleDays));
+
+    std::vector<glm::dvec3> samples(count);
+    for (uint32_t granule = 0; granule < table.body.granuleCount; ++granule) {
+        double granuleStart = startJd + granule * granuleDays;
+        for (unsigned int k = 0; k < count; ++k) {
+            double node = std::cos(pi * (k + 0.5) / count);
+            samples[k] = position(granuleStart + (node + 1.0) * 0.5 * granuleDays);
+        }
+        for (int axis = 0; axis < 3; ++axis) {
+            for (unsigned int j = 0; j < count; ++j) {
+                double sum = 0.0;
+                for (unsigned int k = 0; k < count; ++k) {
+                    sum += samples[k][axis] * std::cos(pi * j * (k + 0.5) / count);
+                }
+                table.coefficients.push_back(sum * (j == 0 ? 1.0 : 2.0) / count);
+            }
+        }
+
+    }
+    return table;
+}
+
+void printUsage() {
+    std::cerr << "Usage: solarscope_ephemgen --out <file> [--start YYYY-MM-DD] [--end YYYY-MM-DD]" << std::endl;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string outPath;
+    double startJd = Ephemeris::julianDate(1950, 1, 1);
+    double endJd = Ephemeris::julianDate(2050, 1, 1);
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--out" && hasValue) {
+            outPath = argv[++i];
+        } else if (arg == "--start" && hasValue && Ephemeris::parseDate(argv[i + 1], startJd)) {
+            ++i;
+        } else if (arg == "--end" && hasValue && Ephemeris::parseDate(argv[i + 1], endJd)) {
+            ++i;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (outPath.empty() || endJd <= startJd) {
+        printUsage();
+        return 1;
+    }
+
+    std::vector<Ephemeris::BodyTable> tables;
+    int earth = -1;
+    for (const Planet& planet : planets) {
+        if (std::string(planet.name) == "earth") {
+            earth = static_cast<int>(tables.size());
+        }
+        tables.push_back(fit(planet.name, -1, planet.granuleDays, planet.coefficientCount, startJd, endJd,
+                             [&planet](double jd) { return planetPosition(planet, jd); }));
+    }
+    tables.push_back(fit("moon", earth, 4.0, 13, startJd, endJd, moonPosition));
+
+    if (!Ephemeris::write(outPath, startJd, endJd, tables)) {
+        return 1;
+    }
+
+    // Read the file back and check the fit between the nodes, relative to the distance
+    Ephemeris ephemeris;
+    if (!ephemeris.open(outPath)) {
+        return 1;
+    }
+    double maxError = 0.0;
+    for (double jd = startJd + 0.37; jd < endJd; jd += 1.13) {
+        for (int i = 0; i < static_cast<int>(std::size(planets)); ++i) {
+            glm::dvec3 exact = planetPosition(planets[i], jd);
+            maxError = std::max(maxError, glm::length(ephemeris.position(i, jd) - exact) / glm::length(exact));
+        }
+        glm::dvec3 exact = moonPosition(jd);
+        int moon = static_cast<int>(std::size(planets));
+        maxError = std::max(maxError, glm::length(ephemeris.position(moon, jd) - exact) / glm::length(exact));
+    }
+
+    size_t coefficients = 0;
+    for (const Ephemeris::BodyTable& table : tables) {
+        coefficients += table.coefficients.size();
+    }
+    std::cout << "Wrote " << outPath << ": " << tables.size() << " bodies, " << Ephemeris::formatDate(startJd)
+              << " to " << Ephemeris::formatDate(endJd) << ", " << coefficients * sizeof(double) / 1024
+              << " KB, max relative fit error " << maxError << std::endl;
+    return 0;
+}
@@ -0,0 +1,86 @@
+// Replays an input recording through the scene without a window or GL context.
+// Prints simulation frame-time statistics and a state checksum, so the same
+// recording can be compared across builds and machines:
+//
+//     ./solarscope_replay stutter.ssir --fixed-dt 0.0166667
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "include/input/InputReplayer.hpp"
+#include "include/utils/Profiler.hpp"
+#include "include/world/SceneController.hpp"
+
+int main(int argc, char* argv[]) {
+    std::string replayPath;
+    std::string tracePath;
+    float fixedDt = 0.0f;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--fixed-dt" && i + 1 < argc) {
+            fixedDt = std::stof(argv[++i]);
+        } else if (arg == "--trace" && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (replayPath.empty() && arg[0] != '-') {
+            replayPath = arg;
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+    if (replayPath.empty()) {
+        std::cerr << "Usage: solarscope_replay <recording> [--fixed-dt <seconds>] [--trace <file>]" << std::endl;
+        return 1;
+    }
+
+    InputReplayer replayer;
+    replayer.fixedDt = fixedDt;
+    if (!replayer.open(replayPath)) {
+        return 1;
+    }
+
+    Profiler& profiler = Profiler::instance();
+    if (!tracePath.empty()) {
+        profiler.startCapture();
+    }
+
+    SceneController scene;
+    scene.solarSystem.scheduler.budgetMicroseconds = 0.0;  // Checksums must not depend on machine speed
+    std::vector<double> frameUs;
+    float simulatedTime = 0.0f;
+    FrameInput input;
+    while (replayer.next(input)) {
+        profiler.beginFrame();
+        double start = profiler.nowUs();
+        scene.update(input);
+        frameUs.push_back(profiler.nowUs() - start);
+        simulatedTime += input.dt;
+        profiler.endFrame();
+    }
+
+    if (!tracePath.empty()) {
+        profiler.stopCapture(tracePath);
+    }
+    if (frameUs.empty()) {
+        std::cerr << "Recording contains no frames" << std::endl;
+        return 1;
+    }
+
+    std::vector<double> sorted = frameUs;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (double us : frameUs) {
+        total += us;
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Frames: " << frameUs.size() << "  simulated time: " << simulatedTime << " s" << std::endl;
+    std::cout << "Update CPU us: mean " << total / frameUs.size() << "  median " << sorted[sorted.size() / 2]
+              << "  max " << sorted.back() << std::endl;
+    std::cout << "State checksum: " << std::hex << scene.stateChecksum() << std::dec << std::endl;
+    profiler.printSummary(std::cout);
+    return 0;
+}
@@ -0,0 +1,270 @@
+// Release performance gate. Runs each perf scenario in the app (scripted input,
+// scripted camera, fixed time step), then compares frame-time percentiles, draw
+// calls, GL state changes and peak memory with a stored baseline. Exit codes:
+//   0  every gated metric is within its threshold
+//   2  a metric grew past its threshold, or a scenario failed to run
+//   3  no regression, but some gated metrics have no baseline value yet (record one
+//      with --update-baseline; until then nothing is actually compared)
+// Run from the repository root:
+//
+//     xvfb-run -a ./build/solarscope_perfgate --app ./build/solarscope
+//
+// Scenarios render with Mesa's software rasterizer by default (LIBGL_ALWAYS_SOFTWARE,
+// llvmpipe), so results depend on the CPU rather than on whichever GPU the machine
+// has. Record the baseline on the reference machine with --update-baseline.
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "include/perf/PerfReport.hpp"
+#include "include/perf/PerfScenario.hpp"
+
+namespace {
+
+struct Baseline {
+    std::map<std::string, double> thresholds;                        // Metric -> allowed growth in percent
+    std::map<std::string, std::map<std::string, double>> values;     // Scene -> metric -> value
+};
+
+struct Result {
+    std::string scene;
+    std::string metric;
+    double value;
+    double baseline;     // Negative when the baseline has no value
+    double threshold;    // Allowed growth in percent, negative when the metric isn't gated
+    bool regressed;
+    bool unbaselined;    // Gated, but the baseline has no value to compare with
+};
+
+bool readBaseline(const std::string& path, Baseline& baseline) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open baseline: " << path << std::endl;
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string first, metric;
+        double value = 0.0;
+        if (!(fields >> first >> metric >> value)) {
+            continue;
+        }
+        if (first == "threshold") {
+            baseline.thresholds[metric] = value;
+        } else {
+            baseline.values[first][metric] = value;
+        }
+    }
+    return true;
+}
+
+bool writeBaseline(const std::string& path, const Baseline& baseline) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to write baseline: " << path << std::endl;
+        return false;
+    }
+    file << "# Performance gate baseline, read by tools/perf_gate.cpp\n";
+    file << "# threshold <metric> <allowed growth in percent>\n";
+    for (const auto& [metric, percent] : baseline.thresholds) {
+        file << "threshold " << metric << " " << percent << "\n";
+    }
+    file << "# <scene> <metric> <value>, recorded with --update-baseline on the reference machine\n";
+    file << std::fixed << std::setprecision(4);
+    for (const auto& [scene, metrics] : baseline.values) {
+        for (const auto& [metric, value] : metrics) {
+            file << scene << " " << metric << " " << value << "\n";
+        }
+    }
+    return true;
+}
+
+void setEnvironment(const char* name, const char* value) {
+#ifdef _WIN32
+    _putenv_s(name, value);
+#else
+    setenv(name, value, 1);
+#endif
+}
+
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::istringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+void writeSummaryJson(const std::string& path, const std::vector<Result>& results, bool passed,
+                      bool baselineMissing) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to write summary: " << path << std::endl;
+        return;
+    }
+    file << std::fixed << std::setprecision(4);
+    file << "{\"passed\":" << (passed ? "true" : "false")
+         << ",\"baseline_missing\":" << (baselineMissing ? "true" : "false") << ",\"results\":[";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        file << (i ? ",\n" : "\n") << "{\"scene\":\"" << result.scene << "\",\"metric\":\"" << result.metric
+             << "\",\"value\":" << result.value;
+        if (result.baseline >= 0.0) {
+            file << ",\"baseline\":" << result.baseline;
+        }
+        if (result.threshold >= 0.0) {
+            file << ",\"threshold_percent\":" << result.threshold;
+        }
+        file << ",\"regressed\":" << (result.regressed ? "true" : "false");
+        file << ",\"missing_baseline\":" << (result.unbaselined ? "true" : "false") << "}";
+    }
+    file << "\n]}\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string appPath = "./solarscope";
+    std::string baselinePath = "perf/baseline.txt";
+    std::string outDir = ".";
+    std::vector<std::string> scenes = PerfScenario::names();
+    bool updateBaseline = false;
+    bool software = true;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--app" && i + 1 < argc) {
+            appPath = argv[++i];
+        } else if (arg == "--baseline" && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (arg == "--out-dir" && i + 1 < argc) {
+            outDir = argv[++i];
+        } else if (arg == "--scenes" && i + 1 < argc) {
+            scenes = splitList(argv[++i]);
+        } else if (arg == "--update-baseline") {
+            updateBaseline = true;
+        } else if (arg == "--hardware") {
+            software = false;
+        } else {
+            std::cerr << "Usage: solarscope_perfgate [--app <path>] [--baseline <file>] [--out-dir <dir>]\n"
+                         "                           [--scenes a,b,...] [--update-baseline] [--hardware]"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    Baseline baseline;
+    if (!readBaseline(baselinePath, baseline)) {
+        return 1;
+    }
+
+    if (software) {
+        setEnvironment("LIBGL_ALWAYS_SOFTWARE", "1");
+        setEnvironment("GALLIUM_DRIVER", "llvmpipe");
+    }
+
+    std::vector<Result> results;
+    bool passed = true;             // No regression and every scenario ran
+    size_t unbaselinedCount = 0;
+    bool allRan = true;
+    for (const std::string& scene : scenes) {
+        PerfScenario scenario;
+        if (!PerfScenario::find(scene, scenario)) {
+            std::cerr << "Unknown perf scenario: " << scene << std::endl;
+            return 1;
+        }
+
+        std::string reportPath = outDir + "/perf_" + scene + ".txt";
+        std::string command = "\"" + appPath + "\" --perf " + scene + " --perf-out \"" + reportPath + "\"";
+        std::cout << "Running " << scene << "..." << std::endl;
+        std::vector<PerfReport::Metric> metrics;
+        if (std::system(command.c_str()) != 0 || !PerfReport::read(reportPath, metrics)) {
+            std::cerr << "Scenario " << scene << " failed to run" << std::endl;
+            passed = false;
+            allRan = false;
+            continue;
+        }
+
+        for (const PerfReport::Metric& metric : metrics) {
+            if (metric.name == "frames") {
+                continue;
+            }
+            Result result{scene, metric.name, metric.value, -1.0, -1.0, false, false};
+            auto threshold = baseline.thresholds.find(metric.name);
+            auto sceneValues = baseline.values.find(scene);
+            if (sceneValues != baseline.values.end()) {
+                auto value = sceneValues->second.find(metric.name);
+                if (value != sceneValues->second.end()) {
+                    result.baseline = value->second;
+                }
+            }
+            if (threshold != baseline.thresholds.end()) {
+                result.threshold = threshold->second;
+                result.unbaselined = result.baseline < 0.0;
+                result.regressed = !result.unbaselined &&
+                                   metric.value > result.baseline * (1.0 + threshold->second / 100.0);
+            }
+            passed = passed && !result.regressed;
+            unbaselinedCount += result.unbaselined;
+            results.push_back(result);
+            if (updateBaseline) {
+                baseline.values[scene][metric.name] = metric.value;
+            }
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    for (const Result& result : results) {
+        std::cout << std::left << std::setw(16) << result.scene << std::setw(16) << result.metric << std::right
+                  << std::setw(12) << result.value;
+        if (result.baseline < 0.0) {
+            std::cout << "  (no baseline)";
+        } else {
+            double change = result.baseline > 0.0 ? (result.value / result.baseline - 1.0) * 100.0 : 0.0;
+            std::cout << std::setw(12) << result.baseline << std::showpos << std::setw(9) << change << "%"
+                      << std::noshowpos;
+        }
+        if (result.regressed) {
+            std::cout << "  REGRESSION (limit +" << result.threshold << "%)";
+        }
+        if (result.unbaselined && !updateBaseline) {
+            std::cout << "  MISSING BASELINE (record one with --update-baseline)";
+        }
+        std::cout << std::endl;
+    }
+
+    bool baselineMissing = unbaselinedCount > 0 && !updateBaseline;
+    writeSummaryJson(outDir + "/perf_summary.json", results, passed && !baselineMissing, baselineMissing);
+
+    if (updateBaseline) {
+        if (!allRan || !writeBaseline(baselinePath, baseline)) {
+            return 1;
+        }
+        std::cout << "Baseline updated: " << baselinePath << std::endl;
+        return 0;
+    }
+
+    if (!passed) {
+        std::cout << "Performance gate FAILED" << std::endl;
+        return 2;
+    }
+    if (baselineMissing) {
+        std::cout << "Performance gate has no baseline recorded yet for " << unbaselinedCount
+                  << " gated metrics; record one with --update-baseline" << std::endl;
+        return 3;
+    }
+    std::cout << "Performance gate passed" << std::endl;
+    return 0;
+}
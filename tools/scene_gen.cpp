@@ -0,0 +1,79 @@
+// Writes a procedurally generated scene for the app's --scene option. The same
+// options and seed always produce the same file:
+//
+//     ./solarscope_scenegen --planets 2000 --moons 2 --moon-depth 2 --asteroids 50000 --seed 7 --out big.scene
+//     ./solarscope --scene big.scene
+//
+// --default writes the built-in solar system instead, as a starting point for hand-edited scenes.
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "include/simulation/SceneFile.hpp"
+#include "include/simulation/SceneGenerator.hpp"
+
+namespace {
+
+void printUsage() {
+    std::cerr << "Usage: solarscope_scenegen --out <file> [--seed N] [--planets N] [--moons N] [--moon-depth N]\n"
+                 "                           [--rings N] [--comets N] [--trail N] [--asteroids N] [--stars N]\n"
+                 "                           [--inner-orbit R] [--outer-orbit R] [--default]"
+              << std::endl;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    SceneGenerator::Options options;
+    std::string outPath;
+    bool writeDefault = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--out" && hasValue) {
+            outPath = argv[++i];
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--planets" && hasValue) {
+            options.planets = std::atoi(argv[++i]);
+        } else if (arg == "--moons" && hasValue) {
+            options.moonsPerBody = std::atoi(argv[++i]);
+        } else if (arg == "--moon-depth" && hasValue) {
+            options.moonDepth = std::atoi(argv[++i]);
+        } else if (arg == "--rings" && hasValue) {
+            options.ringedPlanets = std::atoi(argv[++i]);
+        } else if (arg == "--comets" && hasValue) {
+            options.comets = std::atoi(argv[++i]);
+        } else if (arg == "--trail" && hasValue) {
+            options.maxTrailPoints = std::atoi(argv[++i]);
+        } else if (arg == "--asteroids" && hasValue) {
+            options.asteroids = std::atoi(argv[++i]);
+        } else if (arg == "--stars" && hasValue) {
+            options.companionStars = std::atoi(argv[++i]);
+        } else if (arg == "--inner-orbit" && hasValue) {
+            options.innerOrbit = std::stof(argv[++i]);
+        } else if (arg == "--outer-orbit" && hasValue) {
+            options.outerOrbit = std::stof(argv[++i]);
+        } else if (arg == "--default") {
+            writeDefault = true;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (outPath.empty() || options.planets < 0 || options.moonsPerBody < 0 || options.asteroids < 0 ||
+        options.comets < 0 || options.maxTrailPoints < 1 || options.companionStars < 0 || options.innerOrbit <= 0.0f ||
+        options.outerOrbit < options.innerOrbit) {
+        printUsage();
+        return 1;
+    }
+
+    SolarSystem system = writeDefault ? SolarSystem::createDefault() : SceneGenerator::generate(options);
+    if (!SceneFile::save(outPath, system)) {
+        return 1;
+    }
+
+    std::cout << "Wrote " << outPath << ": " << system.bodies.size() << " bodies, " << system.rings.size()
+              << " rings, " << system.comets.size() << " comets" << std::endl;
+    return 0;
+}